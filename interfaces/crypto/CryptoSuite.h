@@ -19,6 +19,7 @@
  * @date 2021-03-03
  */
 #pragma once
+#include "../../libutilities/Common.h"
 #include "CommonType.h"
 #include "Hash.h"
 #include "KeyFactory.h"
@@ -28,7 +29,7 @@ namespace bcos
 {
 namespace crypto
 {
-class CryptoSuite
+class CryptoSuite : public std::enable_shared_from_this<CryptoSuite>
 {
 public:
     using Ptr = std::shared_ptr<CryptoSuite>;
@@ -39,9 +40,36 @@ public:
         m_symmetricEncryptionHandler(_symmetricEncryptionHandler)
     {}
     virtual ~CryptoSuite() {}
-    Hash::Ptr hashImpl() { return m_hashImpl; }
-    SignatureCrypto::Ptr signatureImpl() { return m_signatureImpl; }
-    SymmetricEncryption::Ptr symmetricEncryptionHandler() { return m_symmetricEncryptionHandler; }
+
+    // keep the suite alive until the process exits and return the raw pointer of it, the objects
+    // created in large numbers (e.g. the decoded transactions and receipts) hold the raw pointer
+    // instead of a copy of the shared pointer, which contends on the refcount in parallel decoding
+    static CryptoSuite* retain(Ptr const& _cryptoSuite)
+    {
+        if (!_cryptoSuite)
+        {
+            return nullptr;
+        }
+        // the suites are only added, and there are only a few of them in a process
+        if (!_cryptoSuite->m_retained.load(std::memory_order_acquire))
+        {
+            static Mutex x_retainedSuites;
+            static std::vector<Ptr> retainedSuites;
+            Guard l(x_retainedSuites);
+            if (!_cryptoSuite->m_retained.load(std::memory_order_relaxed))
+            {
+                retainedSuites.emplace_back(_cryptoSuite);
+                _cryptoSuite->m_retained.store(true, std::memory_order_release);
+            }
+        }
+        return _cryptoSuite.get();
+    }
+    Hash::Ptr const& hashImpl() { return m_hashImpl; }
+    SignatureCrypto::Ptr const& signatureImpl() { return m_signatureImpl; }
+    SymmetricEncryption::Ptr const& symmetricEncryptionHandler()
+    {
+        return m_symmetricEncryptionHandler;
+    }
 
     template <typename T>
     HashType hash(T&& _data)
@@ -62,6 +90,7 @@ private:
     SignatureCrypto::Ptr m_signatureImpl;
     SymmetricEncryption::Ptr m_symmetricEncryptionHandler;
     KeyFactory::Ptr m_keyFactory;
+    std::atomic_bool m_retained = {false};
 };
 }  // namespace crypto
 }  // namespace bcos
@@ -19,7 +19,6 @@
  * @date: 2021-03-23
  */
 #pragma once
-#include "../../libcodec/scale/ScaleEncoderStream.h"
 #include "../../libprotocol/ParallelMerkleProof.h"
 #include "BlockHeader.h"
 #include "Transaction.h"
@@ -28,6 +27,7 @@
 #include "TransactionReceipt.h"
 #include "TransactionReceiptFactory.h"
 #include <tbb/parallel_for.h>
+#include <boost/endian/buffers.hpp>
 
 namespace bcos
 {
@@ -39,6 +39,7 @@ using HashListConstPtr = std::shared_ptr<const HashList>;
 
 using NonceList = std::vector<u256>;
 using NonceListPtr = std::shared_ptr<NonceList>;
+using NonceListConstPtr = std::shared_ptr<const NonceList>;
 
 enum BlockType : int32_t
 {
@@ -63,43 +64,26 @@ public:
 
     virtual bcos::crypto::HashType calculateTransactionRoot() const
     {
-        auto txsRoot = bcos::crypto::HashType();
         // with no transactions
         if (transactionsSize() == 0 && transactionsMetaDataSize() == 0)
         {
-            return txsRoot;
+            return bcos::crypto::HashType();
         }
-
-        std::vector<bytes> transactionsList;
-        if (transactionsSize() > 0)
-        {
-            transactionsList = encodeToCalculateRoot(
-                transactionsSize(), [this](size_t _index) { return transaction(_index)->hash(); });
-        }
-        else if (transactionsMetaDataSize() > 0)
-        {
-            transactionsList = encodeToCalculateRoot(transactionsHashSize(),
-                [this](size_t _index) { return transactionMetaData(_index)->hash(); });
-        }
-
-        txsRoot = calculateMerkleProofRoot(m_transactionFactory->cryptoSuite(), transactionsList);
-        return txsRoot;
+        auto leaves = encodeTransactionsToCalculateRoot();
+        return calculateMerkleProofRoot(
+            m_transactionFactory->cryptoSuite(), ref(leaves), c_merkleLeafSize);
     }
 
     virtual bcos::crypto::HashType calculateReceiptRoot() const
     {
-        auto receiptsRoot = bcos::crypto::HashType();
         // with no receipts
         if (receiptsSize() == 0)
         {
-            return receiptsRoot;
+            return bcos::crypto::HashType();
         }
-
-        auto receiptsList = encodeToCalculateRoot(
-            receiptsSize(), [this](size_t _index) { return receipt(_index)->hash(); });
-        receiptsRoot = calculateMerkleProofRoot(m_receiptFactory->cryptoSuite(), receiptsList);
-
-        return receiptsRoot;
+        auto leaves = encodeReceiptsToCalculateRoot();
+        return calculateMerkleProofRoot(
+            m_receiptFactory->cryptoSuite(), ref(leaves), c_merkleLeafSize);
     }
 
     virtual int32_t version() const = 0;
@@ -137,19 +121,21 @@ public:
     // set transaction metaData
     virtual void appendTransactionMetaData(TransactionMetaData::Ptr _txMetaData) = 0;
 
+    // the nonces of the transactions, the returned list is owned by the caller
     virtual NonceListPtr nonces() const
     {
-        auto nonceList = std::make_shared<NonceList>();
-        if (transactionsSize() == 0)
-        {
-            return nonceList;
-        }
-        for (size_t i = 0; i < transactionsSize(); ++i)
-        {
-            nonceList->push_back(transaction(i)->nonce());
-        }
+        auto nonceList = std::make_shared<NonceList>(transactionsSize());
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, nonceList->size()),
+            [&](const tbb::blocked_range<size_t>& _r) {
+                for (auto i = _r.begin(); i < _r.end(); ++i)
+                {
+                    (*nonceList)[i] = transaction(i)->nonce();
+                }
+            });
         return nonceList;
     }
+    // the nonces shared with the other callers without copying, the list can't be modified
+    virtual NonceListConstPtr cachedNonces() const { return nonces(); }
 
     // get transactions size
     virtual size_t transactionsSize() const = 0;
@@ -164,21 +150,53 @@ public:
     virtual void setNonceList(NonceList&& _nonceList) = 0;
     virtual NonceList const& nonceList() const = 0;
 
+protected:
+    // the merkle leaf of the _index-th transaction or receipt: the SCALE encoded index (fixed-width
+    // little-endian uint64) followed by the hash, so all the leaves have the same size
+    static constexpr size_t c_merkleLeafSize = sizeof(uint64_t) + bcos::crypto::HashType::size;
+    static void encodeMerkleLeaf(size_t _index, bcos::crypto::HashType const& _hash, byte* _leaf)
+    {
+        static_assert(sizeof(size_t) == sizeof(uint64_t), "the index is encoded as uint64");
+        boost::endian::little_uint64_buf_t index(_index);
+        memcpy(_leaf, index.data(), sizeof(uint64_t));
+        memcpy(_leaf + sizeof(uint64_t), _hash.data(), bcos::crypto::HashType::size);
+    }
+    static bytes encodeMerkleLeaf(size_t _index, bcos::crypto::HashType const& _hash)
+    {
+        bytes leaf(c_merkleLeafSize);
+        encodeMerkleLeaf(_index, _hash, leaf.data());
+        return leaf;
+    }
+
+    // the merkle leaves of the transactions (or the metaData without transactions) and receipts,
+    // encoded one after another into one buffer
+    bytes encodeTransactionsToCalculateRoot() const
+    {
+        if (transactionsSize() > 0)
+        {
+            return encodeToCalculateRoot(
+                transactionsSize(), [this](size_t _index) { return transaction(_index)->hash(); });
+        }
+        return encodeToCalculateRoot(transactionsHashSize(),
+            [this](size_t _index) { return transactionMetaData(_index)->hash(); });
+    }
+    bytes encodeReceiptsToCalculateRoot() const
+    {
+        return encodeToCalculateRoot(
+            receiptsSize(), [this](size_t _index) { return receipt(_index)->hash(); });
+    }
+
 private:
-    std::vector<bytes> encodeToCalculateRoot(
-        size_t _listSize, std::function<bcos::crypto::HashType(size_t _index)> _hashFunc) const
+    template <typename HashFunc>
+    bytes encodeToCalculateRoot(size_t _listSize, HashFunc _hashFunc) const
     {
-        std::vector<bytes> encodedList(_listSize);
+        // all the leaves are allocated once, and filled without any stream
+        bytes encodedList(_listSize * c_merkleLeafSize);
         tbb::parallel_for(
             tbb::blocked_range<size_t>(0, _listSize), [&](const tbb::blocked_range<size_t>& _r) {
                 for (auto i = _r.begin(); i < _r.end(); ++i)
                 {
-                    bcos::codec::scale::ScaleEncoderStream stream;
-                    stream << i;
-                    bytes encodedData = stream.data();
-                    auto hash = _hashFunc(i);
-                    encodedData.insert(encodedData.end(), hash.begin(), hash.end());
-                    encodedList[i] = std::move(encodedData);
+                    encodeMerkleLeaf(i, _hashFunc(i), encodedList.data() + i * c_merkleLeafSize);
                 }
             });
         return encodedList;
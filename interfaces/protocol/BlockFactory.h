@@ -39,6 +39,13 @@ public:
         bytes const& _data, bool _calculateHash = true, bool _checkSig = true) = 0;
     virtual Block::Ptr createBlock(
         bytesConstRef _data, bool _calculateHash = true, bool _checkSig = true) = 0;
+    // decode the block lazily, the blockHeader, the transactions and the receipts are decoded on
+    // the first access, for the callers that only require part of the block
+    virtual Block::Ptr createBlockLazily(
+        bytesConstRef _data, bool _calculateHash = true, bool _checkSig = true)
+    {
+        return createBlock(_data, _calculateHash, _checkSig);
+    }
 
     virtual TransactionMetaData::Ptr createTransactionMetaData() = 0;
     virtual TransactionMetaData::Ptr createTransactionMetaData(
@@ -19,6 +19,7 @@
  * @date: 2021-04-9
  */
 #pragma once
+#include "../../libutilities/CodecFields.h"
 #include "../crypto/CommonType.h"
 #include "Protocol.h"
 namespace bcos
@@ -42,17 +43,7 @@ struct ParentInfo
         return this->blockNumber == rhs.blockNumber && this->blockHash == rhs.blockHash;
     }
 
-    template <class Stream, typename = std::enable_if_t<Stream::is_decoder_stream>>
-    friend Stream& operator>>(Stream& _stream, ParentInfo& parentInfo)
-    {
-        return _stream >> parentInfo.blockNumber >> parentInfo.blockHash;
-    }
-
-    template <class Stream, typename = std::enable_if_t<Stream::is_encoder_stream>>
-    friend Stream& operator<<(Stream& _stream, ParentInfo const& parentInfo)
-    {
-        return _stream << parentInfo.blockNumber << parentInfo.blockHash;
-    }
+    BCOS_SCALE_FIELDS(blockNumber, blockHash)
 };
 using ParentInfoList = std::vector<ParentInfo>;
 using ParentInfoListPtr = std::shared_ptr<ParentInfoList>;
@@ -62,17 +53,7 @@ struct Signature
     int64_t index;
     bytes signature;
 
-    template <class Stream, typename = std::enable_if_t<Stream::is_decoder_stream>>
-    friend Stream& operator>>(Stream& _stream, Signature& signature)
-    {
-        return _stream >> signature.index >> signature.signature;
-    }
-
-    template <class Stream, typename = std::enable_if_t<Stream::is_encoder_stream>>
-    friend Stream& operator<<(Stream& _stream, Signature const& signature)
-    {
-        return _stream << signature.index << signature.signature;
-    }
+    BCOS_SCALE_FIELDS(index, signature)
 };
 using SignatureList = std::vector<Signature>;
 using SignatureListPtr = std::shared_ptr<SignatureList>;
@@ -50,7 +50,8 @@ public:
 
     using Ptr = std::shared_ptr<Transaction>;
     using ConstPtr = std::shared_ptr<const Transaction>;
-    explicit Transaction(bcos::crypto::CryptoSuite::Ptr _cryptoSuite) : m_cryptoSuite(_cryptoSuite)
+    explicit Transaction(bcos::crypto::CryptoSuite::Ptr const& _cryptoSuite)
+      : m_cryptoSuite(bcos::crypto::CryptoSuite::retain(_cryptoSuite))
     {}
 
     virtual ~Transaction() {}
@@ -77,11 +78,8 @@ public:
             throw bcos::Exception("Hash mismatch!");
         }
 
-        // check the signatures
-        auto signature = signatureData();
-        auto publicKey = m_cryptoSuite->signatureImpl()->recover(this->hash(), signature);
-        // recover the sender
-        forceSender(m_cryptoSuite->calculateAddress(publicKey).asBytes());
+        // check the signatures and recover the sender
+        recoverSender(hash, signatureData());
     }
 
     virtual int32_t version() const = 0;
@@ -127,7 +125,7 @@ public:
     bool invalid() const { return m_invalid; }
     void setInvalid(bool _invalid) const { m_invalid = _invalid; }
 
-    bcos::crypto::CryptoSuite::Ptr cryptoSuite() { return m_cryptoSuite; }
+    bcos::crypto::CryptoSuite::Ptr cryptoSuite() { return m_cryptoSuite->shared_from_this(); }
 
     void appendKnownNode(bcos::crypto::NodeIDPtr _node) const
     {
@@ -151,8 +149,33 @@ public:
     bcos::crypto::HashType const& batchHash() const { return m_batchHash; }
 
 protected:
+    // check the signature and recover the sender of the verified hash
+    virtual void recoverSender(bcos::crypto::HashType const& _hash, bytesConstRef _signature) const
+    {
+        auto publicKey = m_cryptoSuite->signatureImpl()->recover(_hash, _signature);
+        forceSender(m_cryptoSuite->calculateAddress(publicKey).asBytes());
+    }
+
+    // clear the sender and the states of the tx, for reusing the transaction
+    void reset()
+    {
+        m_sender.clear();
+        m_submitCallback = nullptr;
+        {
+            std::unique_lock<std::shared_mutex> l(x_knownNodeList);
+            m_knownNodeList.clear();
+        }
+        m_batchId = -1;
+        m_batchHash = bcos::crypto::HashType();
+        m_synced = false;
+        m_sealed = false;
+        m_invalid = false;
+        m_systemTx = false;
+    }
+
     mutable bcos::bytes m_sender;
-    bcos::crypto::CryptoSuite::Ptr m_cryptoSuite;
+    // retained until the process exits, see CryptoSuite::retain
+    bcos::crypto::CryptoSuite* m_cryptoSuite;
 
     TxSubmitCallback m_submitCallback;
     // the tx has been synced or not
@@ -33,8 +33,8 @@ class TransactionReceipt
 public:
     using Ptr = std::shared_ptr<TransactionReceipt>;
     using ConstPtr = std::shared_ptr<const TransactionReceipt>;
-    explicit TransactionReceipt(bcos::crypto::CryptoSuite::Ptr _cryptoSuite)
-      : m_cryptoSuite(_cryptoSuite)
+    explicit TransactionReceipt(bcos::crypto::CryptoSuite::Ptr const& _cryptoSuite)
+      : m_cryptoSuite(bcos::crypto::CryptoSuite::retain(_cryptoSuite))
     {}
 
     virtual ~TransactionReceipt() {}
@@ -55,12 +55,16 @@ public:
     virtual int32_t status() const = 0;
     virtual bytesConstRef output() const = 0;
     virtual gsl::span<const LogEntry> logEntries() const = 0;
-    virtual bcos::crypto::CryptoSuite::Ptr cryptoSuite() { return m_cryptoSuite; }
+    virtual bcos::crypto::CryptoSuite::Ptr cryptoSuite()
+    {
+        return m_cryptoSuite->shared_from_this();
+    }
     virtual BlockNumber blockNumber() const = 0;
     // TODO: add error message
 
 protected:
-    bcos::crypto::CryptoSuite::Ptr m_cryptoSuite;
+    // retained until the process exits, see CryptoSuite::retain
+    bcos::crypto::CryptoSuite* m_cryptoSuite;
 };
 using Receipts = std::vector<TransactionReceipt::Ptr>;
 using ReceiptsPtr = std::shared_ptr<Receipts>;
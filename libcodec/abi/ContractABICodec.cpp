@@ -26,117 +26,151 @@ using namespace bcos::codec::abi;
 
 const int ContractABICodec::MAX_BYTE_LENGTH;
 
+bool ContractABICodec::abiOutByFuncSelector(bytesConstRef _data,
+    const std::vector<std::string>& _allTypes, std::vector<std::string>& _out) const
+{
+    std::vector<ABIParamDecoder> decoders;
+    decoders.reserve(_allTypes.size());
+    for (const std::string& type : _allTypes)
+    {
+        decoders.push_back(getParamDecoder(type));
+    }
+    return decodeParams(_data, decoders, _out);
+}
+
 bool ContractABICodec::abiOutByFuncSelector(
-    bytesConstRef _data, const std::vector<std::string>& _allTypes, std::vector<std::string>& _out)
+    bytesConstRef _data, const ABIFunc& _func, std::vector<std::string>& _out) const
 {
-    data = _data;
-    offset = 0;
+    return decodeParams(_data, _func.getParamsDecoder(), _out);
+}
 
-    for (const std::string& type : _allTypes)
+bool ContractABICodec::decodeParams(bytesConstRef _data,
+    const std::vector<ABIParamDecoder>& _decoders, std::vector<std::string>& _out)
+{
+    static const ParamDecoder paramDecoders[] = {nullptr, &ContractABICodec::decodeInt256Param,
+        &ContractABICodec::decodeUint256Param, &ContractABICodec::decodeAddrParam,
+        &ContractABICodec::decodeStringParam};
+
+    std::size_t offset = 0;
+    for (auto decoder : _decoders)
     {
-        if ("int" == type || "int256" == type)
-        {
-            s256 s;
-            deserialize(s, offset);
-            _out.push_back(toString(s));
-        }
-        else if ("uint" == type || "uint256" == type)
-        {
-            u256 u;
-            deserialize(u, offset);
-            _out.push_back(toString(u));
-        }
-        else if ("address" == type)
-        {
-            Address addr;
-            deserialize(addr, offset);
-            _out.push_back(addr.hex());
-        }
-        else if ("string" == type)
-        {
-            u256 stringOffset;
-            deserialize(stringOffset, offset);
-
-            std::string str;
-            deserialize(str, static_cast<std::size_t>(stringOffset));
-            _out.push_back(str);
-        }
-        else
+        auto paramDecoder = paramDecoders[static_cast<std::size_t>(decoder)];
+        if (!paramDecoder)
         {  // unsupport type
             return false;
         }
-
+        _out.push_back(paramDecoder(_data, offset));
         offset += MAX_BYTE_LENGTH;
     }
 
     return true;
 }
 
-// unsigned integer type uint256.
-bytes ContractABICodec::serialise(const int& _in)
+std::string ContractABICodec::decodeInt256Param(bytesConstRef _data, std::size_t _offset)
+{
+    s256 s;
+    deserialize(_data, s, _offset);
+    return toString(s);
+}
+
+std::string ContractABICodec::decodeUint256Param(bytesConstRef _data, std::size_t _offset)
+{
+    u256 u;
+    deserialize(_data, u, _offset);
+    return toString(u);
+}
+
+std::string ContractABICodec::decodeAddrParam(bytesConstRef _data, std::size_t _offset)
+{
+    Address addr;
+    deserialize(_data, addr, _offset);
+    return addr.hex();
+}
+
+std::string ContractABICodec::decodeStringParam(bytesConstRef _data, std::size_t _offset)
 {
-    return serialise((s256)_in);
+    u256 stringOffset;
+    deserialize(_data, stringOffset, _offset);
+
+    std::string str;
+    deserialize(_data, str, static_cast<std::size_t>(stringOffset));
+    return str;
 }
 
 // unsigned integer type uint256.
-bytes ContractABICodec::serialise(const u256& _in)
+bcos::byte* ContractABICodec::encodeTo(byte* _out, const u256& _in)
 {
-    return h256(_in).asBytes();
+    toBigEndian32(_in, _out);
+    return _out + MAX_BYTE_LENGTH;
 }
 
 // two’s complement signed integer type int256.
-bytes ContractABICodec::serialise(const s256& _in)
+bcos::byte* ContractABICodec::encodeTo(byte* _out, const s256& _in)
 {
-    return h256(_in.convert_to<u256>()).asBytes();
+    return encodeTo(_out, _in.convert_to<u256>());
 }
 
 // equivalent to uint8 restricted to the values 0 and 1. For computing the function selector,
 // bool is used
-bytes ContractABICodec::serialise(const bool& _in)
+bcos::byte* ContractABICodec::encodeTo(byte* _out, const bool& _in)
 {
-    return h256(u256(_in ? 1 : 0)).asBytes();
+    memset(_out, 0, MAX_BYTE_LENGTH);
+    _out[MAX_BYTE_LENGTH - 1] = (_in ? 1 : 0);
+    return _out + MAX_BYTE_LENGTH;
 }
 
 // equivalent to uint160, except for the assumed interpretation and language typing. For
 // computing the function selector, address is used.
-// bool is used.
-bytes ContractABICodec::serialise(const Address& _in)
+bcos::byte* ContractABICodec::encodeTo(byte* _out, const Address& _in)
 {
-    return bytes(12, 0) + _in.asBytes();
+    memset(_out, 0, MAX_BYTE_LENGTH - Address::size);
+    memcpy(_out + MAX_BYTE_LENGTH - Address::size, _in.data(), Address::size);
+    return _out + MAX_BYTE_LENGTH;
 }
 
 // binary type of 32 bytes
-bytes ContractABICodec::serialise(const string32& _in)
+bcos::byte* ContractABICodec::encodeTo(byte* _out, const string32& _in)
 {
-    bytes ret(32, 0);
-    bytesConstRef((byte const*)_in.data(), 32).populate(bytesRef(&ret));
-    return ret;
+    memcpy(_out, _in.data(), MAX_BYTE_LENGTH);
+    return _out + MAX_BYTE_LENGTH;
 }
 
-bytes ContractABICodec::serialise(const bytes& _in)
+bcos::byte* ContractABICodec::encodeTo(byte* _out, const bytes& _in)
 {
-    bytes ret;
-    ret = h256(u256(_in.size())).asBytes();
-    ret.resize(ret.size() + (_in.size() + 31) / MAX_BYTE_LENGTH * MAX_BYTE_LENGTH);
-    bytesConstRef(&_in).populate(bytesRef(&ret).getCroppedData(32));
-    return ret;
+    return encodeData(_out, _in.data(), _in.size());
 }
 
 // dynamic sized unicode string assumed to be UTF-8 encoded.
-bytes ContractABICodec::serialise(const std::string& _in)
+bcos::byte* ContractABICodec::encodeTo(byte* _out, const std::string& _in)
+{
+    return encodeData(_out, (byte const*)_in.data(), _in.size());
+}
+
+bcos::byte* ContractABICodec::encodeTo(byte* _out, const std::string_view& _in)
+{
+    return encodeData(_out, (byte const*)_in.data(), _in.size());
+}
+
+bcos::byte* ContractABICodec::encodeTo(byte* _out, const bytesConstRef& _in)
+{
+    return encodeData(_out, _in.data(), _in.size());
+}
+
+// the length word, then the data padded with zeros to the words
+bcos::byte* ContractABICodec::encodeData(byte* _out, byte const* _data, size_t _size)
 {
-    bytes ret;
-    ret = h256(u256(_in.size())).asBytes();
-    ret.resize(ret.size() + (_in.size() + 31) / MAX_BYTE_LENGTH * MAX_BYTE_LENGTH);
-    bytesConstRef(&_in).populate(bytesRef(&ret).getCroppedData(32));
-    return ret;
+    _out = encodeTo(_out, u256(_size));
+    memcpy(_out, _data, _size);
+    auto size = paddedSize(_size);
+    memset(_out + _size, 0, size - _size);
+    return _out + size;
 }
 
-void ContractABICodec::deserialize(s256& out, std::size_t _offset)
+void ContractABICodec::deserialize(bytesConstRef _data, s256& out, std::size_t _offset)
 {
-    validOffset(_offset + MAX_BYTE_LENGTH - 1);
+    validOffset(_data, _offset + MAX_BYTE_LENGTH - 1);
 
-    u256 u = fromBigEndian<u256>(data.getCroppedData(_offset, MAX_BYTE_LENGTH));
+    u256 u = fromBigEndian<u256>(_data.getCroppedData(_offset, MAX_BYTE_LENGTH));
     if (u > u256("0x8fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"))
     {
         auto r =
@@ -150,51 +184,74 @@ void ContractABICodec::deserialize(s256& out, std::size_t _offset)
     }
 }
 
-void ContractABICodec::deserialize(u256& _out, std::size_t _offset)
+void ContractABICodec::deserialize(bytesConstRef _data, u256& _out, std::size_t _offset)
 {
-    validOffset(_offset + MAX_BYTE_LENGTH - 1);
+    validOffset(_data, _offset + MAX_BYTE_LENGTH - 1);
 
-    _out = fromBigEndian<u256>(data.getCroppedData(_offset, MAX_BYTE_LENGTH));
+    _out = fromBigEndian<u256>(_data.getCroppedData(_offset, MAX_BYTE_LENGTH));
 }
 
-void ContractABICodec::deserialize(bool& _out, std::size_t _offset)
+void ContractABICodec::deserialize(bytesConstRef _data, bool& _out, std::size_t _offset)
 {
-    validOffset(_offset + MAX_BYTE_LENGTH - 1);
+    validOffset(_data, _offset + MAX_BYTE_LENGTH - 1);
 
-    u256 ret = fromBigEndian<u256>(data.getCroppedData(_offset, MAX_BYTE_LENGTH));
+    u256 ret = fromBigEndian<u256>(_data.getCroppedData(_offset, MAX_BYTE_LENGTH));
     _out = ret > 0 ? true : false;
 }
 
-void ContractABICodec::deserialize(Address& _out, std::size_t _offset)
+void ContractABICodec::deserialize(bytesConstRef _data, Address& _out, std::size_t _offset)
 {
-    validOffset(_offset + MAX_BYTE_LENGTH - 1);
+    validOffset(_data, _offset + MAX_BYTE_LENGTH - 1);
 
-    data.getCroppedData(_offset + MAX_BYTE_LENGTH - 20, 20).populate(_out.ref());
+    _data.getCroppedData(_offset + MAX_BYTE_LENGTH - 20, 20).populate(_out.ref());
 }
 
-void ContractABICodec::deserialize(string32& _out, std::size_t _offset)
+void ContractABICodec::deserialize(bytesConstRef _data, string32& _out, std::size_t _offset)
 {
-    validOffset(_offset + MAX_BYTE_LENGTH - 1);
+    validOffset(_data, _offset + MAX_BYTE_LENGTH - 1);
 
-    data.getCroppedData(_offset, MAX_BYTE_LENGTH)
+    _data.getCroppedData(_offset, MAX_BYTE_LENGTH)
         .populate(bytesRef((byte*)_out.data(), MAX_BYTE_LENGTH));
 }
 
-void ContractABICodec::deserialize(std::string& _out, std::size_t _offset)
+bytesConstRef ContractABICodec::dynamicData(bytesConstRef _data, std::size_t _offset)
 {
-    validOffset(_offset + MAX_BYTE_LENGTH - 1);
+    validOffset(_data, _offset + MAX_BYTE_LENGTH - 1);
 
-    u256 len = fromBigEndian<u256>(data.getCroppedData(_offset, MAX_BYTE_LENGTH));
-    validOffset(_offset + MAX_BYTE_LENGTH + (std::size_t)len - 1);
-    auto result = data.getCroppedData(_offset + MAX_BYTE_LENGTH, static_cast<size_t>(len));
+    u256 len = fromBigEndian<u256>(_data.getCroppedData(_offset, MAX_BYTE_LENGTH));
+    // compared with the remaining size, the length from the input may overflow std::size_t
+    auto remainingSize = _data.size() - _offset - MAX_BYTE_LENGTH;
+    if (len > remainingSize)
+    {
+        std::stringstream ss;
+        ss << " deserialize failed, invalid length , length is " << len << " , offset is "
+           << _offset << " , data size is " << _data.size();
+
+        throw std::length_error(ss.str());
+    }
+    return _data.getCroppedData(_offset + MAX_BYTE_LENGTH, static_cast<size_t>(len));
+}
+
+void ContractABICodec::deserialize(bytesConstRef _data, std::string& _out, std::size_t _offset)
+{
+    auto result = dynamicData(_data, _offset);
     _out.assign((const char*)result.data(), result.size());
 }
 
-void ContractABICodec::deserialize(bytes& _out, std::size_t _offset)
+void ContractABICodec::deserialize(bytesConstRef _data, bytes& _out, std::size_t _offset)
 {
-    validOffset(_offset + MAX_BYTE_LENGTH - 1);
+    auto result = dynamicData(_data, _offset);
+    _out.assign(result.begin(), result.end());
+}
 
-    u256 len = fromBigEndian<u256>(data.getCroppedData(_offset, MAX_BYTE_LENGTH));
-    validOffset(_offset + MAX_BYTE_LENGTH + (std::size_t)len - 1);
-    _out = data.getCroppedData(_offset + MAX_BYTE_LENGTH, static_cast<size_t>(len)).toBytes();
+void ContractABICodec::deserialize(
+    bytesConstRef _data, std::string_view& _out, std::size_t _offset)
+{
+    auto result = dynamicData(_data, _offset);
+    _out = std::string_view((const char*)result.data(), result.size());
+}
+
+void ContractABICodec::deserialize(bytesConstRef _data, bytesConstRef& _out, std::size_t _offset)
+{
+    _out = dynamicData(_data, _offset);
 }
\ No newline at end of file
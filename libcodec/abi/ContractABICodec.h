@@ -22,7 +22,11 @@
 #include "../../interfaces/crypto/Hash.h"
 #include "../../libutilities/Common.h"
 #include "../../libutilities/DataConvertUtility.h"
+#include "ContractABIType.h"
 #include <boost/algorithm/string.hpp>
+#include <cstring>
+#include <string_view>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -78,6 +82,17 @@ struct ABIElementType<string32> : std::true_type
 {
 };
 
+// the views of string and bytes, borrowed from the decoded data
+template <>
+struct ABIElementType<std::string_view> : std::true_type
+{
+};
+
+template <>
+struct ABIElementType<bytesConstRef> : std::true_type
+{
+};
+
 template <typename T1, typename T2>
 struct ABIElementType<std::pair<T1, T2>>
 {
@@ -114,6 +129,17 @@ struct ABIStringType<std::string> : std::true_type
 {
 };
 
+template <>
+struct ABIStringType<std::string_view> : std::true_type
+{
+};
+
+// encoded as bytes
+template <>
+struct ABIStringType<bytesConstRef> : std::true_type
+{
+};
+
 // check if type of static array
 template <class T>
 struct ABIStaticArray : std::false_type
@@ -248,6 +274,7 @@ struct Offset<T>
  * @by octopuswang
  *
  * Class for serialise and deserialize c++ object in Solidity ABI format.
+ * The codec keeps no encoding or decoding state, one instance can be shared by all the threads.
  * @ref https://solidity.readthedocs.io/en/develop/abi-spec.html
  */
 class ContractABICodec
@@ -255,179 +282,263 @@ class ContractABICodec
 public:
     explicit ContractABICodec(bcos::crypto::Hash::Ptr _hashImpl) : m_hashImpl(_hashImpl) {}
 
+    // the ABI encoding of the value, encoded into one buffer of the exact size
     template <class T>
-    bytes serialise(const T& _t)
+    bytes serialise(const T& _in) const
+    {
+        bytes out(encodedSize(_in));
+        encodeTo(out.data(), _in);
+        return out;
+    }
+
+    template <class T>
+    static size_t encodedSize(const T& _t)
     {  // unsupport type
         (void)_t;
         static_assert(ABIElementType<T>::value, "ABI not support type.");
-        return bytes{};
+        return 0;
+    }
+    // the static types are encoded as one word
+    static size_t encodedSize(const int&) { return MAX_BYTE_LENGTH; }
+    static size_t encodedSize(const std::uint8_t&) { return MAX_BYTE_LENGTH; }
+    static size_t encodedSize(const std::uint32_t&) { return MAX_BYTE_LENGTH; }
+    static size_t encodedSize(const u256&) { return MAX_BYTE_LENGTH; }
+    static size_t encodedSize(const s256&) { return MAX_BYTE_LENGTH; }
+    static size_t encodedSize(const bool&) { return MAX_BYTE_LENGTH; }
+    static size_t encodedSize(const Address&) { return MAX_BYTE_LENGTH; }
+    static size_t encodedSize(const string32&) { return MAX_BYTE_LENGTH; }
+    // the length word and the content padded to the words
+    static size_t encodedSize(const bytes& _in) { return MAX_BYTE_LENGTH + paddedSize(_in.size()); }
+    static size_t encodedSize(const std::string& _in)
+    {
+        return MAX_BYTE_LENGTH + paddedSize(_in.size());
+    }
+    static size_t encodedSize(const std::string_view& _in)
+    {
+        return MAX_BYTE_LENGTH + paddedSize(_in.size());
+    }
+    static size_t encodedSize(const bytesConstRef& _in)
+    {
+        return MAX_BYTE_LENGTH + paddedSize(_in.size());
+    }
+    template <class T, std::size_t N>
+    static size_t encodedSize(const std::array<T, N>& _in);
+    template <class T>
+    static size_t encodedSize(const std::vector<T>& _in);
+    template <class... T>
+    static size_t encodedSize(const std::tuple<T...>& _in);
+
+    /**
+     * @brief writes the ABI encoding of the value in place
+     *
+     * @param _out the output, must hold at least encodedSize(_in) bytes
+     * @param _in the value to be encoded
+     * @return the end of the written data
+     */
+    template <class T>
+    static byte* encodeTo(byte* _out, const T& _t)
+    {  // unsupport type
+        (void)_t;
+        static_assert(ABIElementType<T>::value, "ABI not support type.");
+        return _out;
+    }
+    // signed integer type int.
+    static byte* encodeTo(byte* _out, const int& _in) { return encodeTo(_out, (s256)_in); }
+    static byte* encodeTo(byte* _out, const std::uint8_t& _in)
+    {
+        return encodeTo(_out, (u256)_in);
+    }
+    static byte* encodeTo(byte* _out, const std::uint32_t& _in)
+    {
+        return encodeTo(_out, (u256)_in);
     }
-    // unsigned integer type int.
-    bytes serialise(const int& _in);
 
     // unsigned integer type uint256.
-    bytes serialise(const u256& _in);
+    static byte* encodeTo(byte* _out, const u256& _in);
 
     // two’s complement signed integer type int256.
-    bytes serialise(const s256& _in);
+    static byte* encodeTo(byte* _out, const s256& _in);
 
     // equivalent to uint8 restricted to the values 0 and 1. For computing the function selector,
     // bool is used
-    bytes serialise(const bool& _in);
+    static byte* encodeTo(byte* _out, const bool& _in);
 
     // equivalent to uint160, except for the assumed interpretation and language typing. For
     // computing the function selector, address is used.
-    // bool is used.
-    bytes serialise(const Address& _in);
+    static byte* encodeTo(byte* _out, const Address& _in);
 
     // binary type of 32 bytes
-    bytes serialise(const string32& _in);
+    static byte* encodeTo(byte* _out, const string32& _in);
 
-    bytes serialise(const bytes& _in);
+    static byte* encodeTo(byte* _out, const bytes& _in);
 
     // dynamic sized unicode string assumed to be UTF-8 encoded.
-    bytes serialise(const std::string& _in);
+    static byte* encodeTo(byte* _out, const std::string& _in);
+
+    static byte* encodeTo(byte* _out, const std::string_view& _in);
+    static byte* encodeTo(byte* _out, const bytesConstRef& _in);
 
     // static array
     template <class T, std::size_t N>
-    bytes serialise(const std::array<T, N>& _in);
+    static byte* encodeTo(byte* _out, const std::array<T, N>& _in);
     // dynamic array
     template <class T>
-    bytes serialise(const std::vector<T>& _in);
+    static byte* encodeTo(byte* _out, const std::vector<T>& _in);
 
     // dynamic tuple
     template <class... T>
-    bytes serialise(const std::tuple<T...>& _in);
+    static byte* encodeTo(byte* _out, const std::tuple<T...>& _in);
 
     template <class T>
-    void deserialize(const T& _t, std::size_t _offset)
+    static void deserialize(bytesConstRef _data, const T& _t, std::size_t _offset)
     {  // unsupport type
         (void)_t;
         (void)_offset;
         static_assert(ABIElementType<T>::value, "ABI not support type.");
     }
 
-    void deserialize(s256& out, std::size_t _offset);
+    static void deserialize(bytesConstRef _data, s256& out, std::size_t _offset);
+
+    static void deserialize(bytesConstRef _data, u256& _out, std::size_t _offset);
 
-    void deserialize(u256& _out, std::size_t _offset);
+    static void deserialize(bytesConstRef _data, bool& _out, std::size_t _offset);
 
-    void deserialize(bool& _out, std::size_t _offset);
+    static void deserialize(bytesConstRef _data, Address& _out, std::size_t _offset);
 
-    void deserialize(Address& _out, std::size_t _offset);
+    static void deserialize(bytesConstRef _data, string32& _out, std::size_t _offset);
 
-    void deserialize(string32& _out, std::size_t _offset);
+    static void deserialize(bytesConstRef _data, std::string& _out, std::size_t _offset);
+    static void deserialize(bytesConstRef _data, bytes& _out, std::size_t _offset);
 
-    void deserialize(std::string& _out, std::size_t _offset);
-    void deserialize(bytes& _out, std::size_t _offset);
+    // the views borrow from _data without copying, valid as long as _data
+    static void deserialize(bytesConstRef _data, std::string_view& _out, std::size_t _offset);
+    static void deserialize(bytesConstRef _data, bytesConstRef& _out, std::size_t _offset);
 
     // static array
     template <class T, std::size_t N>
-    void deserialize(std::array<T, N>& _out, std::size_t _offset);
+    static void deserialize(bytesConstRef _data, std::array<T, N>& _out, std::size_t _offset);
     // dynamic array
     template <class T>
-    void deserialize(std::vector<T>& _out, std::size_t _offset);
+    static void deserialize(bytesConstRef _data, std::vector<T>& _out, std::size_t _offset);
 
     template <class... T>
-    void deserialize(std::tuple<T...>& out, std::size_t _offset);
+    static void deserialize(bytesConstRef _data, std::tuple<T...>& out, std::size_t _offset);
 
 private:
     bcos::crypto::Hash::Ptr m_hashImpl;
     static const int MAX_BYTE_LENGTH = 32;
-    // encode or decode offset
-    std::size_t offset{0};
-    // encode temp bytes
-    bytes fixed;
-    bytes dynamic;
-
-    // decode data
-    bytesConstRef data;
 
 private:
-    size_t getOffset() { return offset; }
     // check if offset valid and std::length_error will be throw
-    void validOffset(std::size_t _offset)
+    static void validOffset(bytesConstRef _data, std::size_t _offset)
     {
-        if (_offset >= data.size())
+        if (_offset >= _data.size())
         {
+            // only the positions are reported, the data may be megabytes
             std::stringstream ss;
             ss << " deserialize failed, invalid offset , offset is " << _offset << " , length is "
-               << data.size() << " , data is " << *toHexString(data);
+               << _data.size();
 
             throw std::length_error(ss.str().c_str());
         }
     }
 
     template <class T>
-    std::string toString(const T& _t)
+    static std::string toString(const T& _t)
     {
         std::stringstream ss;
         ss << _t;
         return ss.str();
     }
 
-    inline void abiInAux() { return; }
-
-    template <class T, class... U>
-    void abiInAux(T const& _t, U const&... _u)
+    static size_t paddedSize(size_t _size)
     {
-        bytes out = serialise(_t);
+        return (_size + MAX_BYTE_LENGTH - 1) / MAX_BYTE_LENGTH * MAX_BYTE_LENGTH;
+    }
 
-        if (ABIDynamicType<T>::value)
-        {  // dynamic type
-            dynamic += out;
-            fixed += serialise((u256)offset);
-            offset += out.size();
+    static byte* encodeData(byte* _out, byte const* _data, size_t _size);
+    // the content of the dynamic bytes or string at the offset, borrowed from _data
+    static bytesConstRef dynamicData(bytesConstRef _data, std::size_t _offset);
+
+    // the size of the item in the head (the offset word for the dynamic item) and in the tail
+    template <class T>
+    static size_t itemEncodedSize(const T& _item)
+    {
+        if constexpr (ABIDynamicType<T>::value)
+        {
+            return MAX_BYTE_LENGTH + encodedSize(_item);
         }
         else
-        {  // static type
-            fixed += out;
+        {
+            return Offset<T>::value * MAX_BYTE_LENGTH;
         }
+    }
 
-        abiInAux(_u...);
+    // the static item is encoded in the head, the dynamic item is encoded in the tail with the
+    // offset from _base in the head
+    template <class T>
+    static void encodeItem(byte*& _head, byte*& _tail, byte const* _base, const T& _item)
+    {
+        if constexpr (ABIDynamicType<T>::value)
+        {
+            encodeTo(_head, u256(_tail - _base));
+            _head += MAX_BYTE_LENGTH;
+            _tail = encodeTo(_tail, _item);
+        }
+        else
+        {
+            _head = encodeTo(_head, _item);
+        }
     }
 
-    void abiOutAux() { return; }
+    // the decoding state is kept on the stack: _offset is the position of the next head
+    static void abiOutAux(bytesConstRef, std::size_t) { return; }
 
     template <class T, class... U>
-    void abiOutAux(T& _t, U&... _u)
+    static void abiOutAux(bytesConstRef _data, std::size_t _offset, T& _t, U&... _u)
     {
-        std::size_t _offset = offset;
+        std::size_t itemOffset = _offset;
         // dynamic type, offset position
         if (ABIDynamicType<T>::value)
         {
             u256 dynamicOffset;
-            deserialize(dynamicOffset, offset);
-            _offset = static_cast<std::size_t>(dynamicOffset);
+            deserialize(_data, dynamicOffset, _offset);
+            itemOffset = static_cast<std::size_t>(dynamicOffset);
         }
 
-        deserialize(_t, _offset);
-        // update offset
-        offset = offset + Offset<T>::value * MAX_BYTE_LENGTH;
+        deserialize(_data, _t, itemOffset);
         // decode next element
-        abiOutAux(_u...);
+        abiOutAux(_data, _offset + Offset<T>::value * MAX_BYTE_LENGTH, _u...);
     }
 
+    // decode the param at the offset into the string, indexed by ABIParamDecoder
+    using ParamDecoder = std::string (*)(bytesConstRef _data, std::size_t _offset);
+    static std::string decodeInt256Param(bytesConstRef _data, std::size_t _offset);
+    static std::string decodeUint256Param(bytesConstRef _data, std::size_t _offset);
+    static std::string decodeAddrParam(bytesConstRef _data, std::size_t _offset);
+    static std::string decodeStringParam(bytesConstRef _data, std::size_t _offset);
+    static bool decodeParams(bytesConstRef _data, const std::vector<ABIParamDecoder>& _decoders,
+        std::vector<std::string>& _out);
+
     template <class F, class... Ts, std::size_t... Is>
-    void traverseTuple(std::tuple<Ts...>& tuple, F func, std::index_sequence<Is...>)
+    static void traverseTuple(std::tuple<Ts...>& tuple, F func, std::index_sequence<Is...>)
     {
         return (void(func(std::get<Is>(tuple))), ...);
     }
 
     template <class F, class... Ts>
-    void traverseTuple(std::tuple<Ts...>& tuple, F func)
+    static void traverseTuple(std::tuple<Ts...>& tuple, F func)
     {
         traverseTuple(tuple, func, std::make_index_sequence<sizeof...(Ts)>());
     }
 
 public:
     template <class... T>
-    bool abiOut(bytesConstRef _data, T&... _t)
+    bool abiOut(bytesConstRef _data, T&... _t) const
     {
-        data = _data;
-        offset = 0;
         try
         {
-            abiOutAux(_t...);
+            abiOutAux(_data, 0, _t...);
             return true;
         }
         catch (...)
@@ -437,113 +548,113 @@ public:
     }
 
     template <class... T>
-    bool abiOutHex(const std::string& _data, T&... _t)
+    bool abiOutHex(const std::string& _data, T&... _t) const
     {
         auto dataFromHex = *fromHexString(_data);
         return abiOut(bytesConstRef(&dataFromHex), _t...);
     }
 
     bool abiOutByFuncSelector(bytesConstRef _data, const std::vector<std::string>& _allTypes,
-        std::vector<std::string>& _out);
+        std::vector<std::string>& _out) const;
+    // decode the params with the decoders resolved when the function is parsed, the function can
+    // be found in ABIFuncCache by the selector of the call data
+    bool abiOutByFuncSelector(
+        bytesConstRef _data, const ABIFunc& _func, std::vector<std::string>& _out) const;
 
     template <class... T>
-    bytes abiIn(const std::string& _sig, T const&... _t)
+    bytes abiIn(const std::string& _sig, T const&... _t) const
     {
-        offset = Offset<T...>::value * MAX_BYTE_LENGTH;
-        fixed.clear();
-        dynamic.clear();
-
-        abiInAux(_t...);
-
-        return _sig.empty() ?
-                   fixed + dynamic :
-                   m_hashImpl->hash(_sig).ref().getCroppedData(0, 4).toBytes() + fixed + dynamic;
+        // the heads size is known at compile time, the whole output is allocated at once
+        size_t selectorSize = (_sig.empty() ? 0 : 4);
+        bytes out(selectorSize + (itemEncodedSize(_t) + ... + 0));
+        if (!_sig.empty())
+        {
+            memcpy(out.data(), m_hashImpl->hash(_sig).data(), selectorSize);
+        }
+        auto base = out.data() + selectorSize;
+        auto head = base;
+        auto tail = base + Offset<T...>::value * MAX_BYTE_LENGTH;
+        (encodeItem(head, tail, base, _t), ...);
+        return out;
     }
 
     template <class... T>
-    std::string abiInHex(const std::string& _sig, T const&... _t)
+    std::string abiInHex(const std::string& _sig, T const&... _t) const
     {
         return *toHexString(abiIn(_sig, _t...));
     }
 };
 
-// a fixed-length array of elements of the given type.
 template <class T, std::size_t N>
-bytes ContractABICodec::serialise(const std::array<T, N>& _in)
+size_t ContractABICodec::encodedSize(const std::array<T, N>& _in)
 {
-    bytes offset_bytes;
-    bytes content;
-
-    auto length = N * MAX_BYTE_LENGTH;
+    size_t size = 0;
+    for (const auto& e : _in)
+    {
+        size += itemEncodedSize(e);
+    }
+    return size;
+}
 
+template <class T>
+size_t ContractABICodec::encodedSize(const std::vector<T>& _in)
+{
+    if constexpr (!ABIDynamicType<T>::value)
+    {
+        return MAX_BYTE_LENGTH + _in.size() * Offset<T>::value * MAX_BYTE_LENGTH;
+    }
+    size_t size = MAX_BYTE_LENGTH;
     for (const auto& e : _in)
     {
-        bytes out = serialise(e);
-        content += out;
-        if (ABIDynamicType<T>::value)
-        {  // dynamic
-            offset_bytes += serialise(static_cast<u256>(length));
-            length += out.size();
-        }
+        size += itemEncodedSize(e);
     }
+    return size;
+}
 
-    return offset_bytes + content;
+template <class... T>
+size_t ContractABICodec::encodedSize(const std::tuple<T...>& _in)
+{
+    return std::apply([](const T&... _items) { return (itemEncodedSize(_items) + ... + 0); }, _in);
+}
+
+// a fixed-length array of elements of the given type.
+template <class T, std::size_t N>
+byte* ContractABICodec::encodeTo(byte* _out, const std::array<T, N>& _in)
+{
+    auto head = _out;
+    auto tail = _out + N * Offset<T>::value * MAX_BYTE_LENGTH;
+    for (const auto& e : _in)
+    {
+        encodeItem(head, tail, _out, e);
+    }
+    return ABIDynamicType<T>::value ? tail : head;
 }
 
 // a variable-length array of elements of the given type.
 template <class T>
-bytes ContractABICodec::serialise(const std::vector<T>& _in)
+byte* ContractABICodec::encodeTo(byte* _out, const std::vector<T>& _in)
 {
-    bytes offset_bytes;
-    bytes content;
-
-    auto length = _in.size() * MAX_BYTE_LENGTH;
-
-    offset_bytes += serialise(static_cast<u256>(_in.size()));
+    _out = encodeTo(_out, static_cast<u256>(_in.size()));
+    auto head = _out;
+    auto tail = _out + _in.size() * Offset<T>::value * MAX_BYTE_LENGTH;
     for (const auto& t : _in)
     {
-        bytes out = serialise(t);
-        content += out;
-        if (ABIDynamicType<T>::value)
-        {  // dynamic
-            offset_bytes += serialise(static_cast<u256>(length));
-            length += out.size();
-        }
+        encodeItem(head, tail, _out, t);
     }
-
-    return offset_bytes + content;
+    return ABIDynamicType<T>::value ? tail : head;
 }
 
 template <class... T>
-bytes ContractABICodec::serialise(const std::tuple<T...>& _in)
+byte* ContractABICodec::encodeTo(byte* _out, const std::tuple<T...>& _in)
 {
-    bytes offsetBytes;
-    bytes dynamicContent;
-    auto tupleSize = std::tuple_size<typename std::remove_reference<decltype(_in)>::type>::value;
-    auto length = tupleSize * MAX_BYTE_LENGTH;
-
-    traverseTuple(const_cast<std::tuple<T...>&>(_in), [&](auto& _tupleItem) {
-        bytes out = serialise(_tupleItem);
-
-        if (ABIDynamicType<typename std::remove_const<
-                typename std::remove_reference<decltype(_tupleItem)>::type>::type>::value)
-        {
-            // dynamic
-            dynamicContent += out;
-            offsetBytes += serialise(static_cast<u256>(length));
-            length += out.size();
-        }
-        else
-        {
-            // static
-            offsetBytes += out;
-        }
-    });
-    return offsetBytes + dynamicContent;
+    auto head = _out;
+    auto tail = _out + Offset<T...>::value * MAX_BYTE_LENGTH;
+    std::apply([&](const T&... _items) { (encodeItem(head, tail, _out, _items), ...); }, _in);
+    return tail;
 }
 
 template <class T, std::size_t N>
-void ContractABICodec::deserialize(std::array<T, N>& _out, std::size_t _offset)
+void ContractABICodec::deserialize(bytesConstRef _data, std::array<T, N>& _out, std::size_t _offset)
 {
     for (std::size_t u = 0; u < N; ++u)
     {
@@ -553,23 +664,23 @@ void ContractABICodec::deserialize(std::array<T, N>& _out, std::size_t _offset)
         {  // dynamic type
             // N element offset
             u256 length;
-            deserialize(length, _offset + u * Offset<T>::value * MAX_BYTE_LENGTH);
+            deserialize(_data, length, _offset + u * Offset<T>::value * MAX_BYTE_LENGTH);
             thisOffset = thisOffset + static_cast<std::size_t>(length);
         }
         else
         {
             thisOffset = _offset + u * Offset<T>::value * MAX_BYTE_LENGTH;
         }
-        deserialize(_out[u], thisOffset);
+        deserialize(_data, _out[u], thisOffset);
     }
 }
 
 template <class T>
-void ContractABICodec::deserialize(std::vector<T>& _out, std::size_t _offset)
+void ContractABICodec::deserialize(bytesConstRef _data, std::vector<T>& _out, std::size_t _offset)
 {
     u256 length;
     // vector length
-    deserialize(length, _offset);
+    deserialize(_data, length, _offset);
     _offset += MAX_BYTE_LENGTH;
     _out.resize(static_cast<std::size_t>(length));
 
@@ -581,19 +692,19 @@ void ContractABICodec::deserialize(std::vector<T>& _out, std::size_t _offset)
         {  // dynamic type
             // N element offset
             u256 thisEleOffset;
-            deserialize(thisEleOffset, _offset + u * Offset<T>::value * MAX_BYTE_LENGTH);
+            deserialize(_data, thisEleOffset, _offset + u * Offset<T>::value * MAX_BYTE_LENGTH);
             thisOffset += static_cast<std::size_t>(thisEleOffset);
         }
         else
         {
             thisOffset = _offset + u * Offset<T>::value * MAX_BYTE_LENGTH;
         }
-        deserialize(_out[u], thisOffset);
+        deserialize(_data, _out[u], thisOffset);
     }
 }
 
 template <class... T>
-void ContractABICodec::deserialize(std::tuple<T...>& _out, std::size_t _offset)
+void ContractABICodec::deserialize(bytesConstRef _data, std::tuple<T...>& _out, std::size_t _offset)
 {
     std::size_t localOffset = _offset;
     std::size_t tupleOffset = 0;
@@ -603,14 +714,14 @@ void ContractABICodec::deserialize(std::tuple<T...>& _out, std::size_t _offset)
         {
             // dynamic
             u256 dynamicOffset;
-            deserialize(dynamicOffset, _offset + tupleOffset);
+            deserialize(_data, dynamicOffset, _offset + tupleOffset);
             localOffset = _offset + static_cast<std::size_t>(dynamicOffset);
-            deserialize(_tupleItem, localOffset);
+            deserialize(_data, _tupleItem, localOffset);
         }
         else
         {
             // static
-            deserialize(_tupleItem, _offset + tupleOffset);
+            deserialize(_data, _tupleItem, _offset + tupleOffset);
         }
         tupleOffset +=
             Offset<typename std::remove_const<
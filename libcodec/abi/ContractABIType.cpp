@@ -58,6 +58,12 @@ const std::string strString = "string";
 // For computing the function selector, address is used.
 const std::string strAddr = "address";
 
+// the param types supported by ContractABICodec::abiOutByFuncSelector
+static const std::unordered_map<std::string, ABIParamDecoder> paramDecoders{
+    {"int", ABIParamDecoder::INT256}, {"int256", ABIParamDecoder::INT256},
+    {"uint", ABIParamDecoder::UINT256}, {"uint256", ABIParamDecoder::UINT256},
+    {"address", ABIParamDecoder::ADDR}, {"string", ABIParamDecoder::STRING}};
+
 // Remove the white space characters on both sides
 static void trim(std::string& _str)
 {
@@ -100,6 +106,16 @@ ABI_ELEMENTARY_TYPE ABIInType::getEnumType(const std::string& _strType)
     return type;
 }
 
+ABIParamDecoder bcos::codec::abi::getParamDecoder(const std::string& _strType)
+{
+    auto it = paramDecoders.find(_strType);
+    if (it == paramDecoders.end())
+    {
+        return ABIParamDecoder::UNSUPPORTED;
+    }
+    return it->second;
+}
+
 void ABIInType::clear()
 {
     aet = ABI_ELEMENTARY_TYPE::INVALID;
@@ -258,6 +274,7 @@ bool ABIFunc::parser(const std::string& _sig)
                 return false;
             }
             allParamsType.push_back(at);
+            allParamsDecoder.push_back(getParamDecoder(at.getType()));
             continue;
         }
     }
@@ -278,3 +295,76 @@ bool ABIFunc::parser(const std::string& _sig)
 
     return true;
 }
+
+ABIFunc::ConstPtr ABIFuncCache::getFunc(const std::string& _sig)
+{
+    {
+        ReadGuard l(x_funcs);
+        auto it = m_signatureToFunc.find(_sig);
+        if (it != m_signatureToFunc.end())
+        {
+            return it->second;
+        }
+    }
+    // parse and hash out of the lock
+    auto parsedFunc = std::make_shared<ABIFunc>();
+    if (!parsedFunc->parser(_sig))
+    {
+        return nullptr;
+    }
+    auto selectorValue = selector(m_hashImpl->hash(parsedFunc->getSignature()).data());
+    ABIFunc::ConstPtr func = parsedFunc;
+
+    WriteGuard l(x_funcs);
+    // the function parsed by the other thread is kept
+    auto it = m_signatureToFunc.find(_sig);
+    if (it != m_signatureToFunc.end())
+    {
+        return it->second;
+    }
+    auto selectorIt = m_selectorToFunc.find(selectorValue);
+    if (selectorIt != m_selectorToFunc.end())
+    {
+        // the selector collides with the function of another signature, which makes the call data
+        // of the two functions indistinguishable
+        if (selectorIt->second->getSignature() != func->getSignature())
+        {
+            return nullptr;
+        }
+        // the different spellings of the same function share the parsed function
+        func = selectorIt->second;
+    }
+    else
+    {
+        m_selectorToFunc.emplace(selectorValue, func);
+    }
+    m_signatureToFunc.emplace(_sig, func);
+    return func;
+}
+
+ABIFunc::ConstPtr ABIFuncCache::getFuncBySelector(bytesConstRef _data) const
+{
+    if (_data.size() < 4)
+    {
+        return nullptr;
+    }
+    ReadGuard l(x_funcs);
+    auto it = m_selectorToFunc.find(selector(_data.data()));
+    if (it == m_selectorToFunc.end())
+    {
+        return nullptr;
+    }
+    return it->second;
+}
+
+size_t ABIFuncCache::size() const
+{
+    ReadGuard l(x_funcs);
+    return m_selectorToFunc.size();
+}
+
+std::uint32_t ABIFuncCache::selector(byte const* _data)
+{
+    return ((std::uint32_t)_data[0] << 24) | ((std::uint32_t)_data[1] << 16) |
+           ((std::uint32_t)_data[2] << 8) | (std::uint32_t)_data[3];
+}
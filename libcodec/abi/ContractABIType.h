@@ -19,6 +19,7 @@
  */
 
 #pragma once
+#include "../../interfaces/crypto/Hash.h"
 #include "../../libutilities/Common.h"
 #include "../../libutilities/DataConvertUtility.h"
 #include <boost/algorithm/string.hpp>
@@ -74,12 +75,31 @@ private:
 
 using ABIOutType = ABIInType;
 
+// the decoders used by ContractABICodec::abiOutByFuncSelector, resolved from the type string once
+// so that decoding the params does no string comparison
+enum class ABIParamDecoder : std::uint8_t
+{
+    UNSUPPORTED,  // no decoder for the type
+    INT256,       // int, int256
+    UINT256,      // uint, uint256
+    ADDR,         // address
+    STRING        // string
+};
+
+// get the param decoder by the type string
+ABIParamDecoder getParamDecoder(const std::string& _strType);
+
 class ABIFunc
 {
+public:
+    using Ptr = std::shared_ptr<ABIFunc>;
+    using ConstPtr = std::shared_ptr<const ABIFunc>;
+
 private:
     std::string strFuncName;
     std::string strFuncSignature;
     std::vector<ABIInType> allParamsType;
+    std::vector<ABIParamDecoder> allParamsDecoder;
 
 public:
     // parser contract abi function signature, eg: transfer(string,string,uint256)
@@ -87,10 +107,41 @@ public:
 
 public:
     std::vector<std::string> getParamsType() const;
+    const std::vector<ABIParamDecoder>& getParamsDecoder() const { return allParamsDecoder; }
     inline std::string getSignature() const { return strFuncSignature; }
     inline std::string getFuncName() const { return strFuncName; }
 };
 
+/**
+ * @brief the parsed functions indexed by the signature and by the 4-byte selector, every
+ *        signature is parsed and hashed only once and the lookups are thread safe
+ */
+class ABIFuncCache
+{
+public:
+    using Ptr = std::shared_ptr<ABIFuncCache>;
+    explicit ABIFuncCache(bcos::crypto::Hash::Ptr _hashImpl) : m_hashImpl(_hashImpl) {}
+
+    // get the parsed function of the signature, the signature is parsed and indexed on the first
+    // call, nullptr for the invalid signature or the signature whose selector collides with the
+    // selector of another indexed function
+    ABIFunc::ConstPtr getFunc(const std::string& _sig);
+
+    // get the function whose selector is the first 4 bytes of the call data, nullptr if the
+    // function has not been parsed by getFunc
+    ABIFunc::ConstPtr getFuncBySelector(bytesConstRef _data) const;
+
+    size_t size() const;
+
+private:
+    static std::uint32_t selector(byte const* _data);
+
+    bcos::crypto::Hash::Ptr m_hashImpl;
+    std::unordered_map<std::string, ABIFunc::ConstPtr> m_signatureToFunc;
+    std::unordered_map<std::uint32_t, ABIFunc::ConstPtr> m_selectorToFunc;
+    mutable SharedMutex x_funcs;
+};
+
 }  // namespace abi
 }  // namespace codec
 }  // namespace bcos
@@ -19,6 +19,7 @@
 #pragma once
 #include "Exceptions.h"
 #include "../../libutilities/Common.h"
+#include <array>
 namespace bcos
 {
 namespace codec
@@ -69,6 +70,28 @@ uint32_t compactLen(T val)
         return 4;
     return countBytes(val);
 }
+
+/**
+ * @brief the compact length prefix of the FixedBytes<N>, computed at compile time
+ * @tparam N the size of the FixedBytes
+ */
+template <unsigned N>
+struct FixedBytesPrefix
+{
+    static_assert(N < EncodingCategoryLimits::kMinUint32, "FixedBytes too large");
+    static constexpr size_t size = (N < EncodingCategoryLimits::kMinUint16 ? 1 : 2);
+    static constexpr std::array<byte, size> data()
+    {
+        if constexpr (size == 1)
+        {
+            return {(byte)(N << 2u)};
+        }
+        else
+        {
+            return {(byte)(((N << 2u) + 1) & 0xff), (byte)(((N << 2u) + 1) >> 8u)};
+        }
+    }
+};
 }  // namespace scale
 }  // namespace codec
 }  // namespace bcos
\ No newline at end of file
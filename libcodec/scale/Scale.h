@@ -20,6 +20,7 @@
 #include "Common.h"
 #include "ScaleDecoderStream.h"
 #include "ScaleEncoderStream.h"
+#include "ScaleFields.h"
 #include <boost/system/system_error.hpp>
 #include <boost/throw_exception.hpp>
 #include <gsl/span>
@@ -31,6 +32,35 @@ namespace codec
 {
 namespace scale
 {
+/**
+ * @brief the total size of the scale-encoded values
+ * @tparam Args primitive types to be encoded
+ * @param args data to encode
+ * @return the size in bytes
+ */
+template <typename... Args>
+size_t encodedSize(Args const&... _args)
+{
+    return (scaleEncodedSize(_args) + ... + 0);
+}
+
+/**
+ * @brief encode the values to the end of the caller-owned buffer in one allocation
+ * @tparam Buffer bytes or std::string
+ * @tparam Args primitive types to be encoded
+ * @param _buffer the buffer to append to
+ * @param args data to encode
+ */
+template <class Buffer, typename... Args>
+void encodeTo(Buffer& _buffer, Args const&... _args)
+{
+    auto offset = _buffer.size();
+    auto size = encodedSize(_args...);
+    _buffer.resize(offset + size);
+    ScaleEncoderStream s(gsl::span<byte>((byte*)_buffer.data() + offset, size));
+    (s << ... << _args);
+}
+
 /**
  * @brief convenience function for encoding primitives data to stream
  * @tparam Args primitive types to be encoded
@@ -40,17 +70,16 @@ namespace scale
 template <typename... Args>
 void encode(std::shared_ptr<bytes> _encodeData, Args&&... _args)
 {
-    ScaleEncoderStream s;
-    (s << ... << std::forward<Args>(_args));
-    *_encodeData = s.data();
+    _encodeData->clear();
+    encodeTo(*_encodeData, std::forward<Args>(_args)...);
 }
 
 template <typename... Args>
 bytes encode(Args&&... _args)
 {
-    ScaleEncoderStream s;
-    (s << ... << std::forward<Args>(_args));
-    return s.data();
+    bytes encodeData;
+    encodeTo(encodeData, std::forward<Args>(_args)...);
+    return encodeData;
 }
 
 /**
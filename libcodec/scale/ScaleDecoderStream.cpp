@@ -137,13 +137,22 @@ ScaleDecoderStream& ScaleDecoderStream::operator>>(CompactInteger& v)
 
 ScaleDecoderStream& ScaleDecoderStream::operator>>(std::string& v)
 {
-    std::vector<uint8_t> collection;
-    *this >> collection;
-    v.clear();
-    v.append(collection.begin(), collection.end());
+    auto data = nextBytes(decodeLength());
+    v.assign((char const*)data.data(), data.size());
     return *this;
 }
 
+size_t ScaleDecoderStream::decodeLength()
+{
+    auto length = decodeCompactInteger(*this);
+    if (length > std::numeric_limits<size_t>::max())
+    {
+        BOOST_THROW_EXCEPTION(
+            ScaleDecodeException() << errinfo_comment("exception for TOO_LARGE_LENGTH"));
+    }
+    return length.convert_to<size_t>();
+}
+
 bool ScaleDecoderStream::hasMore(uint64_t n) const
 {
     return static_cast<SizeType>(m_currentIndex + n) <= m_span.size();
@@ -151,12 +160,9 @@ bool ScaleDecoderStream::hasMore(uint64_t n) const
 
 ScaleDecoderStream& ScaleDecoderStream::operator>>(u256& v)
 {
-    bytes decodedBigEndianData;
-    byte size = 32;
-    decodedBigEndianData.resize(size);
-    decodedBigEndianData.assign(m_currentIterator, m_currentIterator + size);
-    m_currentIterator += size;
-    m_currentIndex += size;
-    v = fromBigEndian<u256>(decodedBigEndianData);
+    // construct the u256 from the 32 big-endian bytes directly
+    auto bigEndianData = nextBytes(32);
+    v = 0;
+    boost::multiprecision::import_bits(v, bigEndianData.begin(), bigEndianData.end());
     return *this;
 }
\ No newline at end of file
@@ -22,10 +22,12 @@
 #include "../../libutilities/FixedBytes.h"
 #include "Common.h"
 #include "FixedWidthIntegerCodec.h"
+#include <boost/endian/conversion.hpp>
 #include <boost/multiprecision/cpp_int.hpp>
 #include <boost/optional.hpp>
 #include <boost/variant.hpp>
 #include <array>
+#include <cstring>
 #include <gsl/span>
 
 namespace bcos
@@ -144,16 +146,17 @@ public:
         if constexpr (std::is_same<I, bool>::value)
         {
             v = decodeBool();
-            return *this;
         }
         // check byte
-        if constexpr (sizeof(T) == 1u)
+        else if constexpr (sizeof(T) == 1u)
         {
             v = nextByte();
-            return *this;
         }
         // decode any other integer
-        v = decodeInteger<I>(*this);
+        else
+        {
+            v = decodeInteger<I>(*this);
+        }
         return *this;
     }
 
@@ -209,8 +212,7 @@ public:
     template <unsigned N>
     ScaleDecoderStream& operator>>(FixedBytes<N>& fixedData)
     {
-        bytes decodedData;
-        *this >> decodedData;
+        auto decodedData = nextBytes(decodeLength());
         if (decodedData.size() < FixedBytes<N>::size)
         {
             BOOST_THROW_EXCEPTION(ScaleDecodeException() << errinfo_comment(
@@ -235,10 +237,25 @@ public:
 
         static_assert(std::is_default_constructible_v<mutableT>);
 
-        CompactInteger size{0u};
-        *this >> size;
-
-        auto item_count = size.convert_to<size_type>();
+        auto item_count = decodeLength();
+        // the bytes are copied from the source buffer at once
+        if constexpr (sizeof(T) == 1u)
+        {
+            auto data = nextBytes(item_count);
+            v.assign(data.begin(), data.end());
+            return *this;
+        }
+        // the fixed-width items are checked against the remaining data once and copied in bulk
+        if constexpr (std::is_integral_v<mutableT> && !std::is_same_v<mutableT, bool>)
+        {
+            v = decodeIntegers<mutableT>(item_count);
+            return *this;
+        }
+        if constexpr (IsFixedBytes<mutableT>::value)
+        {
+            v = decodeFixedBytesItems<mutableT>(item_count);
+            return *this;
+        }
         std::vector<mutableT> vec;
         try
         {
@@ -250,18 +267,9 @@ public:
                 ScaleDecodeException()
                 << errinfo_comment("exception for TOO_MANY_ITEMS: " + std::to_string(item_count)));
         }
-        if constexpr (sizeof(T) == 1u)
-        {
-            vec.assign(m_currentIterator, m_currentIterator + item_count);
-            m_currentIterator += item_count;
-            m_currentIndex += item_count;
-        }
-        else
+        for (size_type i = 0u; i < item_count; ++i)
         {
-            for (size_type i = 0u; i < item_count; ++i)
-            {
-                *this >> vec[i];
-            }
+            *this >> vec[i];
         }
         v = std::move(vec);
         return *this;
@@ -363,6 +371,29 @@ public:
      */
     ScaleDecoderStream& operator>>(std::string& v);
 
+    /**
+     * @brief decodes the byte sequence as a view that borrows the source buffer, without copy
+     * @param v the view, valid as long as the source buffer of the stream
+     * @return reference to stream
+     */
+    ScaleDecoderStream& operator>>(gsl::span<byte const>& v)
+    {
+        v = nextBytes(decodeLength());
+        return *this;
+    }
+
+    /**
+     * @brief decodes the string as a view that borrows the source buffer, without copy
+     * @param v the view, valid as long as the source buffer of the stream
+     * @return reference to stream
+     */
+    ScaleDecoderStream& operator>>(std::string_view& v)
+    {
+        auto data = nextBytes(decodeLength());
+        v = std::string_view((char const*)data.data(), data.size());
+        return *this;
+    }
+
     /**
      * @brief hasMore Checks whether n more bytes are available
      * @param n Number of bytes to check
@@ -385,12 +416,97 @@ public:
         ++m_currentIndex;
         return *m_currentIterator++;
     }
+
+    /**
+     * @brief takes the next _size bytes as the view of the source buffer
+     * and advances current byte iterator by _size
+     * @param _size Number of bytes to take
+     * @return the view of the bytes
+     */
+    gsl::span<byte const> nextBytes(size_t _size)
+    {
+        if (!hasMore(_size))
+        {
+            BOOST_THROW_EXCEPTION(ScaleDecodeException() << errinfo_comment(
+                                      "nextBytes exception for NOT_ENOUGH_DATA, required: " +
+                                      std::to_string(_size) + ", remaining: " +
+                                      std::to_string(m_span.size() - m_currentIndex)));
+        }
+        auto data = m_span.subspan(m_currentIndex, _size);
+        m_currentIterator += _size;
+        m_currentIndex += _size;
+        return data;
+    }
     using SizeType = gsl::span<const byte>::size_type;
 
     gsl::span<byte const> span() const { return m_span; }
     SizeType currentIndex() const { return m_currentIndex; }
 
 private:
+    template <class T>
+    struct IsFixedBytes : std::false_type
+    {
+    };
+    template <unsigned N>
+    struct IsFixedBytes<FixedBytes<N>> : std::true_type
+    {
+    };
+
+    // decodes the compact length prefix of the collections
+    size_t decodeLength();
+
+    // takes the view of _count items of _itemSize bytes, checked before any allocation
+    gsl::span<byte const> nextItems(size_t _count, size_t _itemSize)
+    {
+        if (_count > (m_span.size() - m_currentIndex) / _itemSize)
+        {
+            BOOST_THROW_EXCEPTION(ScaleDecodeException() << errinfo_comment(
+                                      "nextItems exception for NOT_ENOUGH_DATA, items: " +
+                                      std::to_string(_count) + ", remaining: " +
+                                      std::to_string(m_span.size() - m_currentIndex)));
+        }
+        return nextBytes(_count * _itemSize);
+    }
+
+    template <class T>
+    std::vector<T> decodeIntegers(size_t _count)
+    {
+        auto data = nextItems(_count, sizeof(T));
+        std::vector<T> items(_count);
+        memcpy(items.data(), data.data(), data.size());
+        if constexpr (boost::endian::order::native != boost::endian::order::little)
+        {
+            for (auto& item : items)
+            {
+                boost::endian::little_to_native_inplace(item);
+            }
+        }
+        return items;
+    }
+
+    template <class T>
+    std::vector<T> decodeFixedBytesItems(size_t _count)
+    {
+        using Prefix = FixedBytesPrefix<T::size>;
+        constexpr auto prefix = Prefix::data();
+        constexpr size_t itemSize = Prefix::size + T::size;
+        auto data = nextItems(_count, itemSize);
+        std::vector<T> items;
+        items.reserve(_count);
+        for (auto it = data.data(); it != data.data() + data.size(); it += itemSize)
+        {
+            // only the canonical length prefix is accepted
+            if (memcmp(it, prefix.data(), Prefix::size) != 0)
+            {
+                BOOST_THROW_EXCEPTION(ScaleDecodeException() << errinfo_comment(
+                                          "exception for invalid FixedBytes, expected size:" +
+                                          std::to_string(T::size)));
+            }
+            items.emplace_back(it + Prefix::size, T::FromPointer);
+        }
+        return items;
+    }
+
     bool decodeBool();
     /**
      * @brief special case of optional values as described in specification
@@ -434,4 +550,8 @@ private:
 };
 }  // namespace scale
 }  // namespace codec
-}  // namespace bcos
\ No newline at end of file
+}  // namespace bcos
+
+// the structs declared with BCOS_SCALE_FIELDS are decoded by the fields, included after the
+// streams are defined
+#include "ScaleFields.h"
@@ -114,25 +114,50 @@ void encodeCompactInteger(const CompactInteger& value, ScaleEncoderStream& out)
         result.push_back(static_cast<uint8_t>(v & 0xFF));  // push back least significant byte
         v >>= 8;
     }
-    for (const uint8_t c : result)
-    {
-        out << c;
-    }
+    out.putBytes(result.data(), result.size());
 }
 
 ScaleEncoderStream& ScaleEncoderStream::operator<<(const u256& _value)
 {
     // convert u256 to big-edian bytes(Note: must be 32bytes)
-    bytes bigEndianData = toBigEndian(_value);
-    m_stream.insert(m_stream.end(), bigEndianData.begin(), bigEndianData.end());
-    return *this;
+    std::array<byte, 32> bigEndianData;
+    if (!m_countOnly)
+    {
+        toBigEndian(_value, bigEndianData);
+    }
+    return putBytes(bigEndianData.data(), bigEndianData.size());
 }
 
 bytes ScaleEncoderStream::data() const
 {
-    bytes buffer(m_stream.size(), 0u);
-    buffer.assign(m_stream.begin(), m_stream.end());
-    return buffer;
+    if (m_buffer)
+    {
+        return bytes(m_buffer->end() - m_size, m_buffer->end());
+    }
+    if (m_countOnly)
+    {
+        return bytes();
+    }
+    return bytes(m_span.data(), m_span.data() + m_size);
+}
+
+ScaleEncoderStream& ScaleEncoderStream::encodeCompactSize(size_t _size)
+{
+    if (_size < EncodingCategoryLimits::kMinUint16)
+    {
+        return putByte(static_cast<uint8_t>(_size << 2u));
+    }
+    if (_size < EncodingCategoryLimits::kMinUint32)
+    {
+        encodeInteger<uint16_t>(static_cast<uint16_t>((_size << 2u) + 1), *this);
+        return *this;
+    }
+    if (_size < EncodingCategoryLimits::kMinBigInteger)
+    {
+        encodeInteger<uint32_t>(static_cast<uint32_t>((_size << 2u) + 2), *this);
+        return *this;
+    }
+    return *this << CompactInteger(_size);
 }
 
 ScaleEncoderStream& ScaleEncoderStream::operator<<(const CompactInteger& v)
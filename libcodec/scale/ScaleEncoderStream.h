@@ -21,7 +21,7 @@
 #include "FixedWidthIntegerCodec.h"
 #include <boost/optional.hpp>
 #include <boost/variant.hpp>
-#include <deque>
+#include <cstring>
 #include <gsl/span>
 #include <type_traits>
 
@@ -37,8 +37,53 @@ public:
     // special tag to differentiate encoding streams from others
     static constexpr auto is_encoder_stream = true;
 
+    // encode into the buffer owned by the stream
+    ScaleEncoderStream() : m_buffer(&m_ownedBuffer) {}
+    // append the encoded data to the growable buffer owned by the caller
+    explicit ScaleEncoderStream(bytes& _buffer) : m_buffer(&_buffer) {}
+    // encode into the pre-sized span owned by the caller, throw ScaleEncodeException on overflow
+    explicit ScaleEncoderStream(gsl::span<byte> _span) : m_span(_span) {}
+    ScaleEncoderStream(ScaleEncoderStream const&) = delete;
+    ScaleEncoderStream& operator=(ScaleEncoderStream const&) = delete;
+
+    /**
+     * @brief the size of the scale-encoded value, calculated without writing any data
+     * @param _value the value to be encoded
+     * @return the size in bytes
+     */
+    template <class T>
+    static size_t encodedSize(T const& _value)
+    {
+        ScaleEncoderStream stream{CountOnly()};
+        stream << _value;
+        return stream.size();
+    }
+
     // get the encoded data
     bytes data() const;
+    // the size of the data encoded by this stream
+    size_t size() const { return m_size; }
+
+    /**
+     * @brief appends the raw bytes, without the length prefix
+     * @param _data the bytes to append
+     * @param _size the number of bytes
+     * @return reference to stream
+     */
+    ScaleEncoderStream& putBytes(byte const* _data, size_t _size)
+    {
+        if (m_buffer)
+        {
+            m_buffer->insert(m_buffer->end(), _data, _data + _size);
+        }
+        else if (!m_countOnly)
+        {
+            checkSpace(_size);
+            memcpy(m_span.data() + m_size, _data, _size);
+        }
+        m_size += _size;
+        return *this;
+    }
 
     /**
      * @brief scale-encodes pair of values
@@ -119,7 +164,7 @@ public:
     template <unsigned N>
     ScaleEncoderStream& operator<<(const FixedBytes<N>& fixedData)
     {
-        return encodeCollection((size_t)FixedBytes<N>::size, fixedData.begin(), fixedData.end());
+        return encodeBytes(fixedData.ref().data(), N);
     }
 
     /**
@@ -131,6 +176,10 @@ public:
     template <class T>
     ScaleEncoderStream& operator<<(const std::vector<T>& c)
     {
+        if constexpr (isByte<T>)
+        {
+            return encodeBytes((byte const*)c.data(), c.size());
+        }
         return encodeCollection(c.size(), c.begin(), c.end());
     }
 
@@ -190,6 +239,10 @@ public:
     template <class T>
     ScaleEncoderStream& operator<<(const gsl::span<T>& v)
     {
+        if constexpr (isByte<std::remove_const_t<T>>)
+        {
+            return encodeBytes((byte const*)v.data(), v.size());
+        }
         return encodeCollection(v.size(), v.begin(), v.end());
     }
 
@@ -203,6 +256,10 @@ public:
     template <typename T, size_t size>
     ScaleEncoderStream& operator<<(const std::array<T, size>& a)
     {
+        if constexpr (isByte<T>)
+        {
+            return putBytes((byte const*)a.data(), size);
+        }
         for (const auto& e : a)
         {
             *this << e;
@@ -229,7 +286,7 @@ public:
      */
     ScaleEncoderStream& operator<<(std::string_view sv)
     {
-        return encodeCollection(sv.size(), sv.begin(), sv.end());
+        return encodeBytes((byte const*)sv.data(), sv.size());
     }
 
     /**
@@ -275,6 +332,17 @@ public:
     ScaleEncoderStream& operator<<(const u256& v);
 
 protected:
+    // the tag of the stream that only counts the encoded size
+    struct CountOnly
+    {
+    };
+    explicit ScaleEncoderStream(CountOnly) : m_countOnly(true) {}
+
+    // the single-byte integers are encoded as they are, so they can be copied in bulk
+    template <class T>
+    static constexpr bool isByte =
+        std::is_integral_v<T> && sizeof(T) == 1 && !std::is_same_v<T, bool>;
+
     template <size_t I, class... Ts>
     void encodeElementOfTuple(const std::tuple<Ts...>& v)
     {
@@ -309,9 +377,9 @@ protected:
      * @return reference to stream
      */
     template <class It>
-    ScaleEncoderStream& encodeCollection(const CompactInteger& size, It&& begin, It&& end)
+    ScaleEncoderStream& encodeCollection(size_t size, It&& begin, It&& end)
     {
-        *this << size;
+        encodeCompactSize(size);
         for (auto&& it = begin; it != end; ++it)
         {
             *this << *it;
@@ -326,15 +394,53 @@ protected:
      */
     ScaleEncoderStream& putByte(uint8_t v)
     {
-        m_stream.emplace_back(v);
+        if (m_buffer)
+        {
+            m_buffer->push_back(v);
+        }
+        else if (!m_countOnly)
+        {
+            checkSpace(1);
+            m_span[m_size] = v;
+        }
+        m_size++;
         return *this;
     }
 
+    // scale-encodes the byte sequence with the compact length prefix
+    ScaleEncoderStream& encodeBytes(byte const* _data, size_t _size)
+    {
+        encodeCompactSize(_size);
+        return putBytes(_data, _size);
+    }
+
+    // compact-encodes the collection size without constructing the CompactInteger
+    ScaleEncoderStream& encodeCompactSize(size_t _size);
+
 private:
     ScaleEncoderStream& encodeOptionalBool(const boost::optional<bool>& v);
-    // std::deque<uint8_t> m_stream;
-    std::deque<uint8_t> m_stream;
+    void checkSpace(size_t _size) const
+    {
+        if (m_size + _size > m_span.size())
+        {
+            BOOST_THROW_EXCEPTION(ScaleEncodeException() << errinfo_comment(
+                                      "encode exception for OUT_OF_SPACE, required: " +
+                                      std::to_string(m_size + _size) +
+                                      ", spanSize: " + std::to_string(m_span.size())));
+        }
+    }
+
+    bytes m_ownedBuffer;
+    // the growable buffer to append to, nullptr when encoding into the span
+    bytes* m_buffer = nullptr;
+    gsl::span<byte> m_span;
+    bool m_countOnly = false;
+    size_t m_size = 0;
 };
 }  // namespace scale
 }  // namespace codec
-}  // namespace bcos
\ No newline at end of file
+}  // namespace bcos
+
+// the structs declared with BCOS_SCALE_FIELDS are encoded by the fields, included after the
+// streams are defined
+#include "ScaleFields.h"
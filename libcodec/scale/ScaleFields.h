@@ -0,0 +1,398 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief fused scale codec for the structs with the field list known at compile time
+ * @file ScaleFields.h
+ */
+#pragma once
+#include "../../libutilities/CodecFields.h"
+#include "ScaleDecoderStream.h"
+#include "ScaleEncoderStream.h"
+#include <boost/endian/conversion.hpp>
+#include <array>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+
+namespace bcos
+{
+namespace codec
+{
+namespace scale
+{
+template <class... Ts>
+class FieldList;
+template <class... Ts>
+FieldList<Ts...> makeFieldList(Ts&... _fields);
+
+// the structs declare the fields in the encoding order by codecFields(), which returns the tuple of
+// the references to the fields (e.g. std::tie(blockNumber, blockHash))
+template <class T, typename = void>
+struct HasScaleFields : std::false_type
+{
+};
+template <class T>
+struct HasScaleFields<T, std::void_t<decltype(std::declval<T const&>().codecFields())>>
+  : std::true_type
+{
+};
+
+// the field list of the struct declaring codecFields()
+template <class T>
+auto scaleFields(T& _value)
+{
+    return std::apply(
+        [](auto&... _fields) { return makeFieldList(_fields...); }, _value.codecFields());
+}
+
+// the encoded size of the fixed-width types, 0 for the types with variable encoded size
+template <class T, typename = void>
+struct FixedEncodedSize : std::integral_constant<size_t, 0>
+{
+};
+template <class T>
+struct FixedEncodedSize<T, std::enable_if_t<std::is_integral_v<T>>>
+  : std::integral_constant<size_t, sizeof(T)>
+{
+};
+template <>
+struct FixedEncodedSize<u256> : std::integral_constant<size_t, 32>
+{
+};
+template <>
+struct FixedEncodedSize<s256> : std::integral_constant<size_t, 32>
+{
+};
+template <unsigned N>
+struct FixedEncodedSize<FixedBytes<N>>
+  : std::integral_constant<size_t, FixedBytesPrefix<N>::size + N>
+{
+};
+// the structs declaring codecFields() are fixed if all the fields are fixed
+template <class T>
+struct FixedEncodedSize<T, std::void_t<decltype(std::declval<T const&>().codecFields())>>
+  : std::integral_constant<size_t, decltype(scaleFields(std::declval<T const&>()))::allFixedSize>
+{
+};
+
+template <class T>
+constexpr size_t fixedEncodedSize = FixedEncodedSize<std::remove_const_t<T>>::value;
+
+template <class T>
+size_t scaleEncodedSize(T const& _value);
+template <class... Ts>
+size_t scaleEncodedSize(FieldList<Ts...> const& _fields);
+
+/**
+ * @brief the references to the fields of a struct, encoded in order
+ *        the runs of the adjacent fixed-width fields are encoded with one memcpy and decoded
+ *        with one bounds check, the other fields are dispatched to the scale streams
+ * @tparam Ts the types of the fields
+ */
+template <class... Ts>
+class FieldList
+{
+public:
+    static constexpr size_t fieldsSize = sizeof...(Ts);
+    // the encoded size of every field, 0 for the variable-size fields
+    static constexpr std::array<size_t, fieldsSize> fieldsFixedSize = {fixedEncodedSize<Ts>...};
+    // the encoded size of all the fixed fields
+    static constexpr size_t fixedSize = (fixedEncodedSize<Ts> + ... + 0);
+    // the encoded size if all the fields are fixed, otherwise 0
+    static constexpr size_t allFixedSize = ((fixedEncodedSize<Ts> > 0) && ...) ? fixedSize : 0;
+
+    explicit FieldList(Ts&... _fields) : m_fields(_fields...) {}
+
+    // the total encoded size, only the variable-size fields are visited
+    size_t encodedSize() const
+    {
+        return fixedSize + variableEncodedSize(std::make_index_sequence<fieldsSize>());
+    }
+
+    void encode(ScaleEncoderStream& _stream) const { encodeFrom<0>(_stream); }
+
+    void decode(ScaleDecoderStream& _stream) const
+    {
+        static_assert(!(std::is_const_v<Ts> || ...), "can't decode into the const fields");
+        decodeFrom<0>(_stream);
+    }
+
+    // store all the fields into _out, only for the fixed field lists
+    void store(byte* _out) const
+    {
+        static_assert(allFixedSize > 0);
+        storeRun<0, fieldsSize>(_out);
+    }
+
+    // load all the fields from _in, only for the fixed field lists
+    void load(byte const* _in) const
+    {
+        static_assert(allFixedSize > 0);
+        loadRun<0, fieldsSize>(_in);
+    }
+
+private:
+    // the end of the run of fixed fields starting from _begin
+    static constexpr size_t runEnd(size_t _begin)
+    {
+        auto end = _begin;
+        while (end < fieldsSize && fieldsFixedSize[end] > 0)
+        {
+            end++;
+        }
+        return end;
+    }
+
+    static constexpr size_t runSize(size_t _begin, size_t _end)
+    {
+        size_t size = 0;
+        for (auto i = _begin; i < _end; i++)
+        {
+            size += fieldsFixedSize[i];
+        }
+        return size;
+    }
+
+    template <size_t... I>
+    size_t variableEncodedSize(std::index_sequence<I...>) const
+    {
+        return (variableFieldSize<I>() + ... + 0);
+    }
+
+    template <size_t I>
+    size_t variableFieldSize() const
+    {
+        if constexpr (fieldsFixedSize[I] > 0)
+        {
+            return 0;
+        }
+        else
+        {
+            return scaleEncodedSize(std::get<I>(m_fields));
+        }
+    }
+
+    template <size_t I>
+    void encodeFrom(ScaleEncoderStream& _stream) const
+    {
+        if constexpr (I < fieldsSize)
+        {
+            constexpr auto end = runEnd(I);
+            if constexpr (end > I)
+            {
+                std::array<byte, runSize(I, end)> run;
+                storeRun<I, end>(run.data());
+                _stream.putBytes(run.data(), run.size());
+                encodeFrom<end>(_stream);
+            }
+            else
+            {
+                _stream << std::get<I>(m_fields);
+                encodeFrom<I + 1>(_stream);
+            }
+        }
+    }
+
+    template <size_t I>
+    void decodeFrom(ScaleDecoderStream& _stream) const
+    {
+        if constexpr (I < fieldsSize)
+        {
+            constexpr auto end = runEnd(I);
+            if constexpr (end > I)
+            {
+                loadRun<I, end>(_stream.nextBytes(runSize(I, end)).data());
+                decodeFrom<end>(_stream);
+            }
+            else
+            {
+                _stream >> std::get<I>(m_fields);
+                decodeFrom<I + 1>(_stream);
+            }
+        }
+    }
+
+    template <size_t I, size_t End>
+    void storeRun(byte* _out) const
+    {
+        if constexpr (I < End)
+        {
+            storeField(std::get<I>(m_fields), _out);
+            storeRun<I + 1, End>(_out + fieldsFixedSize[I]);
+        }
+    }
+
+    template <size_t I, size_t End>
+    void loadRun(byte const* _in) const
+    {
+        if constexpr (I < End)
+        {
+            loadField(std::get<I>(m_fields), _in);
+            loadRun<I + 1, End>(_in + fieldsFixedSize[I]);
+        }
+    }
+
+    template <class T>
+    static void storeField(T const& _field, byte* _out);
+    template <class T>
+    static void loadField(T& _field, byte const* _in);
+
+    std::tuple<Ts&...> m_fields;
+};
+
+/**
+ * @brief makes the field list of the given fields
+ * @param _fields the fields to be encoded in order, the references are kept
+ */
+template <class... Ts>
+FieldList<Ts...> makeFieldList(Ts&... _fields)
+{
+    return FieldList<Ts...>(_fields...);
+}
+
+template <class... Ts>
+ScaleEncoderStream& operator<<(ScaleEncoderStream& _stream, FieldList<Ts...> const& _fields)
+{
+    _fields.encode(_stream);
+    return _stream;
+}
+
+template <class... Ts>
+ScaleDecoderStream& operator>>(ScaleDecoderStream& _stream, FieldList<Ts...> const& _fields)
+{
+    _fields.decode(_stream);
+    return _stream;
+}
+
+template <class T, typename = std::enable_if_t<HasScaleFields<T>::value>>
+ScaleEncoderStream& operator<<(ScaleEncoderStream& _stream, T const& _value)
+{
+    return _stream << scaleFields(_value);
+}
+
+template <class T, typename = std::enable_if_t<HasScaleFields<T>::value>>
+ScaleDecoderStream& operator>>(ScaleDecoderStream& _stream, T& _value)
+{
+    return _stream >> scaleFields(_value);
+}
+
+/**
+ * @brief the encoded size of the value, the field lists and the structs declared with
+ *        BCOS_SCALE_FIELDS are sized without visiting the fixed fields
+ */
+template <class T>
+size_t scaleEncodedSize(T const& _value)
+{
+    if constexpr (HasScaleFields<T>::value)
+    {
+        return scaleFields(_value).encodedSize();
+    }
+    else
+    {
+        return ScaleEncoderStream::encodedSize(_value);
+    }
+}
+template <class... Ts>
+size_t scaleEncodedSize(FieldList<Ts...> const& _fields)
+{
+    return _fields.encodedSize();
+}
+
+template <class... Ts>
+template <class T>
+void FieldList<Ts...>::storeField(T const& _field, byte* _out)
+{
+    if constexpr (std::is_same_v<T, bool>)
+    {
+        *_out = (_field ? 1u : 0u);
+    }
+    else if constexpr (std::is_integral_v<T>)
+    {
+        auto value = boost::endian::native_to_little(_field);
+        memcpy(_out, &value, sizeof(T));
+    }
+    else if constexpr (std::is_same_v<T, u256>)
+    {
+        toBigEndian32(_field, _out);
+    }
+    else if constexpr (std::is_same_v<T, s256>)
+    {
+        storeField(s2u(_field), _out);
+    }
+    else if constexpr (HasScaleFields<T>::value)
+    {
+        scaleFields(_field).store(_out);
+    }
+    else
+    {
+        // FixedBytes<N>
+        using Prefix = FixedBytesPrefix<T::size>;
+        constexpr auto prefix = Prefix::data();
+        memcpy(_out, prefix.data(), Prefix::size);
+        memcpy(_out + Prefix::size, _field.data(), T::size);
+    }
+}
+
+template <class... Ts>
+template <class T>
+void FieldList<Ts...>::loadField(T& _field, byte const* _in)
+{
+    if constexpr (std::is_same_v<T, bool>)
+    {
+        if (*_in > 1u)
+        {
+            BOOST_THROW_EXCEPTION(ScaleDecodeException()
+                                  << errinfo_comment("decodeBool exception for UNEXPECTED_VALUE"));
+        }
+        _field = (*_in == 1u);
+    }
+    else if constexpr (std::is_integral_v<T>)
+    {
+        T value;
+        memcpy(&value, _in, sizeof(T));
+        _field = boost::endian::little_to_native(value);
+    }
+    else if constexpr (std::is_same_v<T, u256>)
+    {
+        _field = 0;
+        boost::multiprecision::import_bits(_field, _in, _in + 32);
+    }
+    else if constexpr (std::is_same_v<T, s256>)
+    {
+        u256 value;
+        loadField(value, _in);
+        _field = u2s(value);
+    }
+    else if constexpr (HasScaleFields<T>::value)
+    {
+        scaleFields(_field).load(_in);
+    }
+    else
+    {
+        // FixedBytes<N>, only the canonical length prefix is accepted
+        using Prefix = FixedBytesPrefix<T::size>;
+        constexpr auto prefix = Prefix::data();
+        if (memcmp(_in, prefix.data(), Prefix::size) != 0)
+        {
+            BOOST_THROW_EXCEPTION(
+                ScaleDecodeException() << errinfo_comment(
+                    "exception for invalid FixedBytes, expected size:" + std::to_string(T::size)));
+        }
+        _field = T(_in + Prefix::size, T::FromPointer);
+    }
+}
+}  // namespace scale
+}  // namespace codec
+}  // namespace bcos
@@ -0,0 +1,70 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief: columnar view of the transactions and receipts of a block
+ *
+ * @file: BlockColumns.cpp
+ */
+
+#include "BlockColumns.h"
+#include <tbb/parallel_invoke.h>
+
+using namespace bcos;
+using namespace bcos::crypto;
+using namespace bcos::protocol;
+
+BlockColumns::BlockColumns(Block const& _block)
+{
+    auto txsSize = _block.transactionsSize();
+    auto receiptsSize = _block.receiptsSize();
+    m_txsHash.resize(txsSize);
+    m_status.resize(receiptsSize);
+    m_gasUsed.resize(receiptsSize);
+    m_logEntriesSize.resize(receiptsSize);
+    tbb::parallel_invoke(
+        [&]() {
+            // resolve every transaction once, the lazily decoded block takes the lock and copies
+            // the pointer on every access
+            std::vector<Transaction::ConstPtr> txs(txsSize);
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, txsSize),
+                [&](const tbb::blocked_range<size_t>& _r) {
+                    for (auto i = _r.begin(); i < _r.end(); ++i)
+                    {
+                        txs[i] = _block.transaction(i);
+                        m_txsHash[i] = txs[i]->hash();
+                    }
+                });
+            tbb::parallel_invoke(
+                [&]() {
+                    m_senders.build(
+                        txsSize, [&](size_t _index) { return txs[_index]->sender(); });
+                },
+                [&]() {
+                    m_to.build(txsSize, [&](size_t _index) { return txs[_index]->to(); });
+                });
+        },
+        [&]() {
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, receiptsSize),
+                [&](const tbb::blocked_range<size_t>& _r) {
+                    for (auto i = _r.begin(); i < _r.end(); ++i)
+                    {
+                        auto receipt = _block.receipt(i);
+                        m_status[i] = receipt->status();
+                        m_gasUsed[i] = receipt->gasUsed();
+                        m_logEntriesSize[i] = receipt->logEntries().size();
+                    }
+                });
+        });
+}
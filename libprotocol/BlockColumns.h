@@ -0,0 +1,122 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief: columnar view of the transactions and receipts of a block
+ *
+ * @file: BlockColumns.h
+ */
+#pragma once
+
+#include "../interfaces/protocol/Block.h"
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+namespace bcos
+{
+namespace protocol
+{
+// the variable-length values stored back to back in one buffer
+class StringColumn
+{
+public:
+    size_t size() const { return m_offsets.empty() ? 0 : m_offsets.size() - 1; }
+    std::string_view operator[](size_t _index) const
+    {
+        return std::string_view(
+            m_data.data() + m_offsets[_index], m_offsets[_index + 1] - m_offsets[_index]);
+    }
+
+    // fill the column with _size values in parallel, _valueFunc is called twice per value and
+    // should be cheap
+    template <typename ValueFunc>
+    void build(size_t _size, ValueFunc _valueFunc);
+
+private:
+    std::string m_data;
+    // the value i is m_data[m_offsets[i], m_offsets[i + 1])
+    std::vector<size_t> m_offsets;
+};
+
+/**
+ * @brief the struct-of-arrays view of a decoded block
+ *
+ * The ledger writes and the RPC scans that read one field of all the transactions or receipts go
+ * through the contiguous columns instead of chasing a pointer per transaction.
+ * The view is built in parallel and copies all the fields, it's immutable and can be shared
+ * after the build, but won't be updated with the block
+ */
+class BlockColumns
+{
+public:
+    using Ptr = std::shared_ptr<BlockColumns>;
+    using ConstPtr = std::shared_ptr<const BlockColumns>;
+    explicit BlockColumns(Block const& _block);
+    virtual ~BlockColumns() {}
+
+    // the transaction columns
+    size_t transactionsSize() const { return m_txsHash.size(); }
+    bcos::crypto::HashList const& transactionsHash() const { return m_txsHash; }
+    // the senders are empty for the transactions whose signatures are not checked, e.g. the
+    // block decoded with checkSig=false
+    StringColumn const& senders() const { return m_senders; }
+    StringColumn const& to() const { return m_to; }
+
+    // the receipt columns
+    size_t receiptsSize() const { return m_status.size(); }
+    std::vector<int32_t> const& status() const { return m_status; }
+    std::vector<u256> const& gasUsed() const { return m_gasUsed; }
+    std::vector<uint32_t> const& logEntriesSize() const { return m_logEntriesSize; }
+
+private:
+    bcos::crypto::HashList m_txsHash;
+    StringColumn m_senders;
+    StringColumn m_to;
+
+    std::vector<int32_t> m_status;
+    std::vector<u256> m_gasUsed;
+    std::vector<uint32_t> m_logEntriesSize;
+};
+
+template <typename ValueFunc>
+void StringColumn::build(size_t _size, ValueFunc _valueFunc)
+{
+    // calculate the offsets with the sizes of the values, then copy the values in parallel
+    m_offsets.assign(_size + 1, 0);
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, _size), [&](const tbb::blocked_range<size_t>& _r) {
+            for (auto i = _r.begin(); i < _r.end(); ++i)
+            {
+                m_offsets[i + 1] = _valueFunc(i).size();
+            }
+        });
+    for (size_t i = 0; i < _size; i++)
+    {
+        m_offsets[i + 1] += m_offsets[i];
+    }
+    m_data.resize(m_offsets[_size]);
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, _size), [&](const tbb::blocked_range<size_t>& _r) {
+            for (auto i = _r.begin(); i < _r.end(); ++i)
+            {
+                auto value = _valueFunc(i);
+                memcpy(m_data.data() + m_offsets[i], value.data(), value.size());
+            }
+        });
+}
+}  // namespace protocol
+}  // namespace bcos
@@ -0,0 +1,242 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief: reusable 16-ary merkle tree that keeps all the interior levels
+ *
+ * @file: MerkleTree.cpp
+ */
+
+#include "MerkleTree.h"
+#include "ParallelMerkleProof.h"
+#include "../libcodec/scale/ScaleDecoderStream.h"
+#include "../libcodec/scale/ScaleEncoderStream.h"
+#include <tbb/parallel_for.h>
+
+using namespace bcos;
+using namespace bcos::crypto;
+using namespace bcos::protocol;
+using namespace bcos::codec::scale;
+
+const uint32_t MAX_CHILD_COUNT = MERKLE_MAX_CHILD_COUNT;
+
+MerkleTree::MerkleTree(Hash::Ptr _hashImpl, bytesConstRef _leaves, size_t _leafSize)
+  : MerkleTree(_hashImpl)
+{
+    std::vector<bytes> leaves(_leaves.size() / _leafSize);
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, leaves.size()), [&](const tbb::blocked_range<size_t>& _r) {
+            for (auto i = _r.begin(); i < _r.end(); ++i)
+            {
+                auto leaf = _leaves.data() + i * _leafSize;
+                leaves[i].assign(leaf, leaf + _leafSize);
+            }
+        });
+    build(std::move(leaves));
+}
+
+void MerkleTree::build(std::vector<bytes>&& _leaves)
+{
+    m_leaves = std::move(_leaves);
+    m_levels.clear();
+    size_t level = 0;
+    while (levelSize(level) > 1)
+    {
+        auto parentsSize = (levelSize(level) + MAX_CHILD_COUNT - 1) / MAX_CHILD_COUNT;
+        m_levels.emplace_back(parentsSize);
+        auto& parents = m_levels.back();
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, parentsSize), [&](const tbb::blocked_range<size_t>& _r) {
+                for (auto i = _r.begin(); i < _r.end(); ++i)
+                {
+                    parents[i] = hashChildren(level, i);
+                }
+            });
+        level++;
+    }
+}
+
+void MerkleTree::appendLeaf(bytes&& _leaf)
+{
+    m_leaves.emplace_back(std::move(_leaf));
+    updatePath(m_leaves.size() - 1);
+}
+
+void MerkleTree::updateLeaf(size_t _index, bytes&& _leaf)
+{
+    if (_index >= m_leaves.size())
+    {
+        BOOST_THROW_EXCEPTION(MerkleLeafIndexOutOfRange() << errinfo_comment(
+                                  "updateLeaf out of range, index: " + std::to_string(_index) +
+                                  ", leavesSize: " + std::to_string(m_leaves.size())));
+    }
+    m_leaves[_index] = std::move(_leaf);
+    updatePath(_index);
+}
+
+HashType MerkleTree::root() const
+{
+    if (m_leaves.empty())
+    {
+        return m_hashImpl->hash(bytes());
+    }
+    auto level = m_levels.size();
+    return m_hashImpl->hash(node(level, 0));
+}
+
+MerkleProof MerkleTree::generateProof(size_t _index) const
+{
+    if (_index >= m_leaves.size())
+    {
+        BOOST_THROW_EXCEPTION(MerkleLeafIndexOutOfRange() << errinfo_comment(
+                                  "generateProof out of range, index: " + std::to_string(_index) +
+                                  ", leavesSize: " + std::to_string(m_leaves.size())));
+    }
+    MerkleProof proof;
+    proof.leafIndex = _index;
+    auto childIndex = _index;
+    for (size_t level = 0; levelSize(level) > 1; level++)
+    {
+        auto begin = (childIndex / MAX_CHILD_COUNT) * MAX_CHILD_COUNT;
+        auto end = std::min(begin + MAX_CHILD_COUNT, levelSize(level));
+        if (level > 0)
+        {
+            proof.siblingHashes.emplace_back();
+            proof.siblingHashes.back().reserve(end - begin - 1);
+        }
+        for (auto i = begin; i < end; i++)
+        {
+            if (i == childIndex)
+            {
+                continue;
+            }
+            if (level == 0)
+            {
+                proof.siblingLeaves.emplace_back(m_leaves[i]);
+            }
+            else
+            {
+                proof.siblingHashes.back().emplace_back(m_levels[level - 1][i]);
+            }
+        }
+        childIndex /= MAX_CHILD_COUNT;
+    }
+    return proof;
+}
+
+bool MerkleTree::verifyProof(
+    Hash::Ptr _hashImpl, MerkleProof const& _proof, bytesConstRef _leaf, HashType const& _root)
+{
+    auto const& siblingLeaves = _proof.siblingLeaves;
+    // the only leaf of the tree
+    if (siblingLeaves.empty() && _proof.siblingHashes.empty())
+    {
+        return _proof.leafIndex == 0 && _hashImpl->hash(_leaf) == _root;
+    }
+    auto position = _proof.leafIndex % MAX_CHILD_COUNT;
+    if (siblingLeaves.size() >= MAX_CHILD_COUNT || position > siblingLeaves.size())
+    {
+        return false;
+    }
+    bytes childrenData;
+    for (size_t i = 0; i < siblingLeaves.size(); i++)
+    {
+        if (i == position)
+        {
+            childrenData.insert(childrenData.end(), _leaf.begin(), _leaf.end());
+        }
+        childrenData.insert(childrenData.end(), siblingLeaves[i].begin(), siblingLeaves[i].end());
+    }
+    if (position == siblingLeaves.size())
+    {
+        childrenData.insert(childrenData.end(), _leaf.begin(), _leaf.end());
+    }
+    auto current = _hashImpl->hash(childrenData);
+
+    auto index = _proof.leafIndex / MAX_CHILD_COUNT;
+    HashList children;
+    children.reserve(MAX_CHILD_COUNT);
+    for (auto const& siblings : _proof.siblingHashes)
+    {
+        position = index % MAX_CHILD_COUNT;
+        if (siblings.size() >= MAX_CHILD_COUNT || position > siblings.size())
+        {
+            return false;
+        }
+        children.assign(siblings.begin(), siblings.end());
+        children.insert(children.begin() + position, current);
+        current = hashMerkleChildren(_hashImpl, children.data(), children.size());
+        index /= MAX_CHILD_COUNT;
+    }
+    // the leaf index must be consistent with the height of the proof
+    return index == 0 && _hashImpl->hash(current.ref()) == _root;
+}
+
+bytes MerkleProof::encode() const
+{
+    ScaleEncoderStream stream;
+    stream << leafIndex << siblingLeaves << siblingHashes;
+    return stream.data();
+}
+
+void MerkleProof::decode(bytesConstRef _data)
+{
+    ScaleDecoderStream stream(gsl::span<byte const>(_data.data(), _data.size()));
+    stream >> leafIndex >> siblingLeaves >> siblingHashes;
+}
+
+bytesConstRef MerkleTree::node(size_t _level, size_t _index) const
+{
+    if (_level == 0)
+    {
+        return ref(m_leaves[_index]);
+    }
+    return m_levels[_level - 1][_index].ref();
+}
+
+HashType MerkleTree::hashChildren(size_t _level, size_t _parentIndex) const
+{
+    auto begin = _parentIndex * MAX_CHILD_COUNT;
+    auto size = std::min((size_t)MAX_CHILD_COUNT, levelSize(_level) - begin);
+    if (_level == 0)
+    {
+        return hashMerkleLeaves(m_hashImpl, &m_leaves[begin], size);
+    }
+    return hashMerkleChildren(m_hashImpl, &m_levels[_level - 1][begin], size);
+}
+
+void MerkleTree::updatePath(size_t _leafIndex)
+{
+    auto childIndex = _leafIndex;
+    for (size_t level = 0; levelSize(level) > 1; level++)
+    {
+        // the tree grows higher
+        if (m_levels.size() <= level)
+        {
+            m_levels.emplace_back();
+        }
+        auto parentIndex = childIndex / MAX_CHILD_COUNT;
+        auto parentHash = hashChildren(level, parentIndex);
+        auto& parents = m_levels[level];
+        if (parentIndex < parents.size())
+        {
+            parents[parentIndex] = parentHash;
+        }
+        else
+        {
+            parents.emplace_back(parentHash);
+        }
+        childIndex = parentIndex;
+    }
+}
@@ -0,0 +1,106 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief: reusable 16-ary merkle tree that keeps all the interior levels
+ *
+ * @file: MerkleTree.h
+ */
+#pragma once
+
+#include "../interfaces/crypto/Hash.h"
+#include "../libutilities/Common.h"
+#include "../libutilities/Exceptions.h"
+#include <vector>
+
+namespace bcos
+{
+namespace protocol
+{
+DERIVE_BCOS_EXCEPTION(MerkleLeafIndexOutOfRange);
+
+/**
+ * @brief the compact proof of a leaf, generated in O(log16(n))
+ *
+ * Only the siblings of the path from the leaf to the top level are kept, the position of the
+ * proved node in every level is derived from the leaf index.
+ * Note: the proof of the only leaf of the tree has no siblings at all
+ */
+struct MerkleProof
+{
+    uint64_t leafIndex = 0;
+    // the other leaves under the parent of the proved leaf
+    std::vector<bytes> siblingLeaves;
+    // the sibling hashes of every interior level, from the bottom level to the top level
+    std::vector<bcos::crypto::HashList> siblingHashes;
+
+    // the binary (SCALE) format of the proof
+    bytes encode() const;
+    void decode(bytesConstRef _data);
+};
+
+/**
+ * @brief the 16-ary merkle tree, the root is the same as calculateMerkleProofRoot
+ *
+ * All the interior levels are kept, so appending or updating a leaf only rehashes the path from
+ * the leaf to the top in O(log16(n)), and the proof of a leaf is generated without rebuilding.
+ * Note: the tree is not thread-safe, the caller should serialize the modifications
+ */
+class MerkleTree
+{
+public:
+    using Ptr = std::shared_ptr<MerkleTree>;
+    using ConstPtr = std::shared_ptr<const MerkleTree>;
+    explicit MerkleTree(bcos::crypto::Hash::Ptr _hashImpl) : m_hashImpl(_hashImpl) {}
+    MerkleTree(bcos::crypto::Hash::Ptr _hashImpl, std::vector<bytes>&& _leaves)
+      : MerkleTree(_hashImpl)
+    {
+        build(std::move(_leaves));
+    }
+    // build from the _leafSize-byte leaves encoded one after another in _leaves
+    MerkleTree(bcos::crypto::Hash::Ptr _hashImpl, bytesConstRef _leaves, size_t _leafSize);
+    virtual ~MerkleTree() {}
+
+    // build all the levels from the given leaves in parallel
+    void build(std::vector<bytes>&& _leaves);
+    void appendLeaf(bytes&& _leaf);
+    void updateLeaf(size_t _index, bytes&& _leaf);
+
+    size_t leavesSize() const { return m_leaves.size(); }
+    bytes const& leaf(size_t _index) const { return m_leaves.at(_index); }
+
+    bcos::crypto::HashType root() const;
+
+    // the compact proof of the given leaf
+    MerkleProof generateProof(size_t _index) const;
+    static bool verifyProof(bcos::crypto::Hash::Ptr _hashImpl, MerkleProof const& _proof,
+        bytesConstRef _leaf, bcos::crypto::HashType const& _root);
+
+private:
+    // the number of nodes of the given level, level 0 is the leaf level
+    size_t levelSize(size_t _level) const
+    {
+        return _level == 0 ? m_leaves.size() : m_levels[_level - 1].size();
+    }
+    bytesConstRef node(size_t _level, size_t _index) const;
+    bcos::crypto::HashType hashChildren(size_t _level, size_t _parentIndex) const;
+    void updatePath(size_t _leafIndex);
+
+    bcos::crypto::Hash::Ptr m_hashImpl;
+    std::vector<bytes> m_leaves;
+    // m_levels[i] is the parent level of level i, the last one is the top level
+    std::vector<bcos::crypto::HashList> m_levels;
+};
+}  // namespace protocol
+}  // namespace bcos
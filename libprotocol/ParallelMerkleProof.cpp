@@ -22,50 +22,106 @@
 
 #include "ParallelMerkleProof.h"
 #include <tbb/parallel_for.h>
-#include <mutex>
 
 using namespace bcos;
 using namespace bcos::crypto;
+using namespace bcos::protocol;
 
-const uint32_t MAX_CHILD_COUNT = 16;
+const uint32_t MAX_CHILD_COUNT = bcos::protocol::MERKLE_MAX_CHILD_COUNT;
+// the leaf is the compact encoded index with the 32-bytes hash in general
+const size_t MAX_STACK_LEAF_SIZE = 64;
 
-HashType bcos::protocol::calculateMerkleProofRoot(
-    CryptoSuite::Ptr _cryptoSuite, const std::vector<bcos::bytes>& _bytesCaches)
+HashType bcos::protocol::hashMerkleLeaves(
+    Hash::Ptr const& _hashImpl, bcos::bytes const* _leaves, size_t _size)
 {
-    if (_bytesCaches.empty())
+    std::array<byte, MAX_CHILD_COUNT * MAX_STACK_LEAF_SIZE> buffer;
+    size_t offset = 0;
+    for (size_t i = 0; i < _size; i++)
     {
-        return _cryptoSuite->hash(bytes());
+        auto const& leaf = _leaves[i];
+        if (offset + leaf.size() > buffer.size())
+        {
+            // the leaves are too large for the stack buffer
+            bytes childrenData;
+            for (size_t j = 0; j < _size; j++)
+            {
+                childrenData.insert(childrenData.end(), _leaves[j].begin(), _leaves[j].end());
+            }
+            return _hashImpl->hash(childrenData);
+        }
+        memcpy(buffer.data() + offset, leaf.data(), leaf.size());
+        offset += leaf.size();
     }
-    std::vector<bcos::bytes> bytesCachesTemp;
-    bytesCachesTemp.insert(bytesCachesTemp.end(),
-        std::make_move_iterator(const_cast<std::vector<bcos::bytes>&>(_bytesCaches).begin()),
-        std::make_move_iterator(const_cast<std::vector<bcos::bytes>&>(_bytesCaches).end()));
+    return _hashImpl->hash(bytesConstRef(buffer.data(), offset));
+}
 
-    while (bytesCachesTemp.size() > 1)
+// _hashLeaves(begin, size) hashes the given (no more than MAX_CHILD_COUNT) leaves
+template <typename HashLeavesFunc>
+static HashType calculateMerkleRoot(
+    Hash::Ptr const& _hashImpl, size_t _leavesSize, HashLeavesFunc _hashLeaves)
+{
+    if (_leavesSize == 0)
+    {
+        return _hashImpl->hash(bytes());
+    }
+    if (_leavesSize == 1)
+    {
+        return _hashLeaves(0, 1);
+    }
+    // the interior levels are written into two pre-allocated buffers in turn:
+    // level 1, 3, 5... into the first one, and level 2, 4, 6... into the second one
+    size_t levelSize = (_leavesSize + MAX_CHILD_COUNT - 1) / MAX_CHILD_COUNT;
+    HashList levelBuffers[2] = {HashList(levelSize),
+        HashList(levelSize > 1 ? (levelSize + MAX_CHILD_COUNT - 1) / MAX_CHILD_COUNT : 0)};
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, levelSize), [&](const tbb::blocked_range<size_t>& _r) {
+            for (auto i = _r.begin(); i < _r.end(); ++i)
+            {
+                auto begin = i * MAX_CHILD_COUNT;
+                auto size = std::min((size_t)MAX_CHILD_COUNT, _leavesSize - begin);
+                levelBuffers[0][i] = _hashLeaves(begin, size);
+            }
+        });
+    size_t level = 1;
+    while (levelSize > 1)
     {
-        std::vector<bcos::bytes> higherLevelList;
-        int size = (bytesCachesTemp.size() + MAX_CHILD_COUNT - 1) / MAX_CHILD_COUNT;
-        higherLevelList.resize(size);
+        auto const& children = levelBuffers[(level - 1) % 2];
+        auto& parents = levelBuffers[level % 2];
+        auto childrenSize = levelSize;
+        levelSize = (childrenSize + MAX_CHILD_COUNT - 1) / MAX_CHILD_COUNT;
         tbb::parallel_for(
-            tbb::blocked_range<size_t>(0, size), [&](const tbb::blocked_range<size_t>& _r) {
-                for (uint32_t i = _r.begin(); i < _r.end(); ++i)
+            tbb::blocked_range<size_t>(0, levelSize), [&](const tbb::blocked_range<size_t>& _r) {
+                for (auto i = _r.begin(); i < _r.end(); ++i)
                 {
-                    bytes byteValue;
-                    for (uint32_t j = 0; j < MAX_CHILD_COUNT; j++)
-                    {
-                        uint32_t index = i * MAX_CHILD_COUNT + j;
-                        if (index < bytesCachesTemp.size())
-                        {
-                            byteValue.insert(byteValue.end(), bytesCachesTemp[index].begin(),
-                                bytesCachesTemp[index].end());
-                        }
-                    }
-                    higherLevelList[i] = _cryptoSuite->hash(byteValue).asBytes();
+                    auto begin = i * MAX_CHILD_COUNT;
+                    auto size = std::min((size_t)MAX_CHILD_COUNT, childrenSize - begin);
+                    parents[i] = hashMerkleChildren(_hashImpl, &children[begin], size);
                 }
             });
-        bytesCachesTemp = std::move(higherLevelList);
+        level++;
     }
-    return _cryptoSuite->hash(bytesCachesTemp[0]);
+    auto const& top = levelBuffers[(level - 1) % 2][0];
+    return _hashImpl->hash(top.ref());
+}
+
+HashType bcos::protocol::calculateMerkleProofRoot(
+    CryptoSuite::Ptr _cryptoSuite, const std::vector<bcos::bytes>& _bytesCaches)
+{
+    auto hashImpl = _cryptoSuite->hashImpl();
+    return calculateMerkleRoot(hashImpl, _bytesCaches.size(), [&](size_t _begin, size_t _size) {
+        return hashMerkleLeaves(hashImpl, &_bytesCaches[_begin], _size);
+    });
+}
+
+HashType bcos::protocol::calculateMerkleProofRoot(
+    CryptoSuite::Ptr _cryptoSuite, bytesConstRef _leaves, size_t _leafSize)
+{
+    auto hashImpl = _cryptoSuite->hashImpl();
+    // the sibling leaves are adjacent in the buffer, and hashed without copying
+    return calculateMerkleRoot(
+        hashImpl, _leaves.size() / _leafSize, [&](size_t _begin, size_t _size) {
+            return hashImpl->hash(_leaves.getCroppedData(_begin * _leafSize, _size * _leafSize));
+        });
 }
 
 void bcos::protocol::calculateMerkleProof(bcos::crypto::CryptoSuite::Ptr _cryptoSuite,
@@ -76,44 +132,67 @@ void bcos::protocol::calculateMerkleProof(bcos::crypto::CryptoSuite::Ptr _crypto
     {
         return;
     }
-    std::vector<bcos::bytes> bytesCachesTemp;
-    bytesCachesTemp.insert(bytesCachesTemp.end(),
-        std::make_move_iterator(const_cast<std::vector<bcos::bytes>&>(_bytesCaches).begin()),
-        std::make_move_iterator(const_cast<std::vector<bcos::bytes>&>(_bytesCaches).end()));
-    std::mutex mapMutex;
-    while (bytesCachesTemp.size() > 1)
+    auto hashImpl = _cryptoSuite->hashImpl();
+    // calculate all the interior levels, levels[i] is the parent level of level i
+    std::vector<HashList> levels;
+    size_t childrenSize = _bytesCaches.size();
+    while (childrenSize > 1)
     {
-        std::vector<bcos::bytes> higherLevelList;
-        int size = (bytesCachesTemp.size() + MAX_CHILD_COUNT - 1) / MAX_CHILD_COUNT;
-        higherLevelList.resize(size);
+        auto parentsSize = (childrenSize + MAX_CHILD_COUNT - 1) / MAX_CHILD_COUNT;
+        levels.emplace_back(parentsSize);
+        auto& parents = levels.back();
+        auto level = levels.size() - 1;
         tbb::parallel_for(
-            tbb::blocked_range<size_t>(0, size), [&](const tbb::blocked_range<size_t>& _r) {
-                for (uint32_t i = _r.begin(); i < _r.end(); ++i)
+            tbb::blocked_range<size_t>(0, parentsSize), [&](const tbb::blocked_range<size_t>& _r) {
+                for (auto i = _r.begin(); i < _r.end(); ++i)
                 {
-                    bytes byteValue;
-                    std::vector<bcos::bytes> childList;
-                    for (uint32_t j = 0; j < MAX_CHILD_COUNT; j++)
-                    {
-                        uint32_t index = i * MAX_CHILD_COUNT + j;
-                        if (index < bytesCachesTemp.size())
-                        {
-                            byteValue.insert(byteValue.end(), bytesCachesTemp[index].begin(),
-                                bytesCachesTemp[index].end());
-                            childList.push_back(bytesCachesTemp[index]);
-                        }
-                    }
-                    higherLevelList[i] = _cryptoSuite->hash(byteValue).asBytes();
-                    std::lock_guard<std::mutex> l(mapMutex);
-                    std::string parentNode = *toHexString(higherLevelList[i]);
-                    for (const auto& child : childList)
+                    auto begin = i * MAX_CHILD_COUNT;
+                    auto size = std::min((size_t)MAX_CHILD_COUNT, childrenSize - begin);
+                    parents[i] = (level == 0) ?
+                                     hashMerkleLeaves(hashImpl, &_bytesCaches[begin], size) :
+                                     hashMerkleChildren(hashImpl, &levels[level - 1][begin], size);
+                }
+            });
+        childrenSize = parentsSize;
+    }
+
+    // hex-encode the entries of every level in parallel, each parent owns its own slot
+    using Parent2Children = std::pair<std::string, std::vector<std::string>>;
+    std::vector<std::vector<Parent2Children>> entries(levels.size());
+    for (size_t level = 0; level < levels.size(); level++)
+    {
+        auto const& parents = levels[level];
+        auto levelEntriesSize = level == 0 ? _bytesCaches.size() : levels[level - 1].size();
+        entries[level].resize(parents.size());
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, parents.size()),
+            [&](const tbb::blocked_range<size_t>& _r) {
+                for (auto i = _r.begin(); i < _r.end(); ++i)
+                {
+                    auto& entry = entries[level][i];
+                    entry.first = parents[i].hex();
+                    auto begin = i * MAX_CHILD_COUNT;
+                    auto end = std::min(begin + MAX_CHILD_COUNT, levelEntriesSize);
+                    entry.second.reserve(end - begin);
+                    for (auto j = begin; j < end; j++)
                     {
-                        (*_parent2ChildList)[parentNode].emplace_back(*toHexString(child));
+                        entry.second.emplace_back(level == 0 ? *toHexString(_bytesCaches[j]) :
+                                                               levels[level - 1][j].hex());
                     }
                 }
             });
-        bytesCachesTemp = std::move(higherLevelList);
     }
-
-    (*_parent2ChildList)[*toHexString(_cryptoSuite->hash(bytesCachesTemp[0]).asBytes())].push_back(
-        *toHexString(bytesCachesTemp[0]));
+    // only the map insertion is serial
+    for (auto& levelEntries : entries)
+    {
+        for (auto& entry : levelEntries)
+        {
+            auto& children = (*_parent2ChildList)[entry.first];
+            children.insert(children.end(), std::make_move_iterator(entry.second.begin()),
+                std::make_move_iterator(entry.second.end()));
+        }
+    }
+    // the root is the hash of the top node
+    bytes top = levels.empty() ? _bytesCaches[0] : levels.back()[0].asBytes();
+    (*_parent2ChildList)[*toHexString(hashImpl->hash(top).asBytes())].push_back(
+        *toHexString(top));
 }
@@ -29,8 +29,27 @@ namespace bcos
 {
 namespace protocol
 {
+const uint32_t MERKLE_MAX_CHILD_COUNT = 16;
+static_assert(sizeof(bcos::crypto::HashType) == bcos::crypto::HashType::size,
+    "the merkle interior levels require the contiguous HashType array");
+
+// hash the given (no more than MERKLE_MAX_CHILD_COUNT) contiguous children of the interior level
+inline bcos::crypto::HashType hashMerkleChildren(
+    bcos::crypto::Hash::Ptr const& _hashImpl, bcos::crypto::HashType const* _children, size_t _size)
+{
+    return _hashImpl->hash(bytesConstRef(_children->data(), _size * bcos::crypto::HashType::size));
+}
+// hash the given (no more than MERKLE_MAX_CHILD_COUNT) leaves from a stack buffer
+bcos::crypto::HashType hashMerkleLeaves(
+    bcos::crypto::Hash::Ptr const& _hashImpl, bcos::bytes const* _leaves, size_t _size);
+
 bcos::crypto::HashType calculateMerkleProofRoot(
     bcos::crypto::CryptoSuite::Ptr _cryptoSuite, const std::vector<bcos::bytes>& _bytesCaches);
+// the root of the _leafSize-byte leaves encoded one after another in _leaves
+bcos::crypto::HashType calculateMerkleProofRoot(
+    bcos::crypto::CryptoSuite::Ptr _cryptoSuite, bytesConstRef _leaves, size_t _leafSize);
+// the full parent => children map (hex encoded) of all the nodes, which is memory-consuming,
+// use MerkleTree::generateProof for the proof of a single leaf
 void calculateMerkleProof(bcos::crypto::CryptoSuite::Ptr _cryptoSuite,
     const std::vector<bcos::bytes>& _bytesCaches,
     std::shared_ptr<std::map<std::string, std::vector<std::string>>> _parent2ChildList);
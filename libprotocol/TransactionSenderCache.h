@@ -0,0 +1,168 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief process-wide cache of the senders recovered from the transaction signatures
+ * @file TransactionSenderCache.h
+ */
+#pragma once
+#include "../interfaces/crypto/CommonType.h"
+#include "../libutilities/Common.h"
+#include <algorithm>
+#include <array>
+#include <deque>
+
+namespace bcos
+{
+namespace protocol
+{
+/**
+ * @brief bounded concurrent cache of (tx hash, signature) => sender
+ *
+ * A transaction is verified when it enters the txpool, and verified again every time it is
+ * decoded from a proposal or a synced block. The cache makes sure that the signature recover
+ * runs only once per transaction per node.
+ * The signature is stored together with the sender, so a transaction carrying the same hash but a
+ * different signature never hits the cache.
+ */
+class TransactionSenderCache
+{
+public:
+    using Ptr = std::shared_ptr<TransactionSenderCache>;
+    explicit TransactionSenderCache(size_t _capacity = c_defaultCapacity)
+    {
+        setCapacity(_capacity);
+    }
+    virtual ~TransactionSenderCache() {}
+
+    // the process-wide cache used by PBTransaction::verify
+    static TransactionSenderCache& instance()
+    {
+        static TransactionSenderCache cache;
+        return cache;
+    }
+
+    // set the max number of cached senders, 0 means disable the cache
+    void setCapacity(size_t _capacity)
+    {
+        m_bucketCapacity = (_capacity + c_bucketNum - 1) / c_bucketNum;
+    }
+    size_t capacity() const { return m_bucketCapacity * c_bucketNum; }
+
+    bool get(bcos::crypto::HashType const& _txHash, bytesConstRef _signature, bytes& _sender) const
+    {
+        auto const& bucket = m_buckets[bucketIndex(_txHash)];
+        ReadGuard l(bucket.x_senders);
+        auto it = bucket.senders.find(_txHash);
+        if (it == bucket.senders.end())
+        {
+            return false;
+        }
+        auto const& signature = it->second.signature;
+        if (signature.size() != _signature.size() ||
+            !std::equal(signature.begin(), signature.end(), _signature.begin()))
+        {
+            return false;
+        }
+        _sender = it->second.sender;
+        return true;
+    }
+
+    void insert(
+        bcos::crypto::HashType const& _txHash, bytesConstRef _signature, bytes const& _sender)
+    {
+        size_t bucketCapacity = m_bucketCapacity;
+        if (bucketCapacity == 0)
+        {
+            return;
+        }
+        auto& bucket = m_buckets[bucketIndex(_txHash)];
+        WriteGuard l(bucket.x_senders);
+        auto result = bucket.senders.insert_or_assign(
+            _txHash, SenderInfo{_signature.toBytes(), _sender});
+        if (result.second)
+        {
+            bucket.insertOrder.push_back(_txHash);
+        }
+        // evict the earliest inserted senders
+        while (bucket.senders.size() > bucketCapacity && !bucket.insertOrder.empty())
+        {
+            bucket.senders.erase(bucket.insertOrder.front());
+            bucket.insertOrder.pop_front();
+        }
+    }
+
+    void erase(bcos::crypto::HashType const& _txHash)
+    {
+        auto& bucket = m_buckets[bucketIndex(_txHash)];
+        WriteGuard l(bucket.x_senders);
+        if (bucket.senders.erase(_txHash) == 0)
+        {
+            return;
+        }
+        // the stale hash would evict the sender re-inserted later before its turn
+        auto it = std::find(bucket.insertOrder.begin(), bucket.insertOrder.end(), _txHash);
+        if (it != bucket.insertOrder.end())
+        {
+            bucket.insertOrder.erase(it);
+        }
+    }
+
+    size_t size() const
+    {
+        size_t cachedSize = 0;
+        for (auto const& bucket : m_buckets)
+        {
+            ReadGuard l(bucket.x_senders);
+            cachedSize += bucket.senders.size();
+        }
+        return cachedSize;
+    }
+
+    void clear()
+    {
+        for (auto& bucket : m_buckets)
+        {
+            WriteGuard l(bucket.x_senders);
+            bucket.senders.clear();
+            bucket.insertOrder.clear();
+        }
+    }
+
+private:
+    static size_t bucketIndex(bcos::crypto::HashType const& _txHash)
+    {
+        return std::hash<bcos::crypto::HashType>()(_txHash) % c_bucketNum;
+    }
+
+    struct SenderInfo
+    {
+        bytes signature;
+        bytes sender;
+    };
+    struct Bucket
+    {
+        mutable SharedMutex x_senders;
+        std::unordered_map<bcos::crypto::HashType, SenderInfo> senders;
+        // the insert order of the hashes, used to evict the earliest senders
+        std::deque<bcos::crypto::HashType> insertOrder;
+    };
+
+    static constexpr size_t c_bucketNum = 64;
+    static constexpr size_t c_defaultCapacity = 100000;
+    std::array<Bucket, c_bucketNum> m_buckets;
+    std::atomic<size_t> m_bucketCapacity = {0};
+};
+}  // namespace protocol
+}  // namespace bcos
@@ -22,15 +22,27 @@
 #include "../../interfaces/protocol/Exceptions.h"
 #include "../Common.h"
 #include "PBTransactionMetaData.h"
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format.h>
+#include <google/protobuf/wire_format_lite.h>
 #include <tbb/parallel_invoke.h>
 
 using namespace bcos;
 using namespace bcos::protocol;
 using namespace bcos::crypto;
+using namespace google::protobuf::io;
+using namespace google::protobuf::internal;
 
 void PBBlock::decode(bytesConstRef _data, bool _calculateHash, bool _checkSig)
 {
     decodePBObject(m_pbRawBlock, _data);
+    resetTransactionsMerkleTree();
+    resetReceiptsMerkleTree();
+    resetNonces();
+    m_lazyBlockHeader = false;
+    m_lazyTransactions = false;
+    m_lazyReceipts = false;
+    m_lazyNonceList = false;
     tbb::parallel_invoke(
         [this]() {
             // decode blockHeader
@@ -56,8 +68,42 @@ void PBBlock::decode(bytesConstRef _data, bool _calculateHash, bool _checkSig)
         [this]() { decodeNonceList(); });
 }
 
+void PBBlock::decodeLazily(bytesConstRef _data, bool _calculateHash, bool _checkSig)
+{
+    decodePBObject(m_pbRawBlock, _data);
+    resetTransactionsMerkleTree();
+    resetReceiptsMerkleTree();
+    resetNonces();
+    m_calculateHash = _calculateHash;
+    m_checkSig = _checkSig;
+    if (m_pbRawBlock->header().size() > 0)
+    {
+        m_blockHeader = nullptr;
+        m_lazyBlockHeader = true;
+    }
+    // only allocate the transactions and the receipts, the raw data is kept in m_pbRawBlock
+    if (m_pbRawBlock->transactions_size() > 0)
+    {
+        m_transactions->clear();
+        m_transactions->resize(m_pbRawBlock->transactions_size());
+        m_lazyTransactions = true;
+    }
+    if (m_pbRawBlock->receipts_size() > 0)
+    {
+        m_receipts->clear();
+        m_receipts->resize(m_pbRawBlock->receipts_size());
+        m_lazyReceipts = true;
+    }
+    // the metaData only holds the pointers to m_pbRawBlock, no need to decode lazily
+    decodeTransactionsMetaData();
+    m_lazyNonceList = (m_pbRawBlock->noncelist_size() > 0);
+}
+
 void PBBlock::encode(bytes& _encodedData) const
 {
+    // the encoded transactions and receipts that are not cached in m_pbRawBlock
+    std::vector<bytesConstRef> encodedTxs;
+    std::vector<bytesConstRef> encodedReceipts;
     tbb::parallel_invoke(
         [this]() {
             // encode blockHeader
@@ -69,13 +115,13 @@ void PBBlock::encode(bytes& _encodedData) const
             m_blockHeader->encode(*encodedData);
             m_pbRawBlock->set_header(encodedData->data(), encodedData->size());
         },
-        [this]() {
+        [this, &encodedTxs]() {
             // encode transactions
-            encodeTransactions();
+            encodeTransactions(encodedTxs);
         },
-        [this]() {
+        [this, &encodedReceipts]() {
             // encode receipts
-            encodeReceipts();
+            encodeReceipts(encodedReceipts);
         },
         [this]() {
             // encode transactions hash
@@ -85,8 +131,39 @@ void PBBlock::encode(bytes& _encodedData) const
             // encode the nonceList
             encodeNonceList();
         });
-    auto data = encodePBObject(m_pbRawBlock);
-    _encodedData = *data;
+    auto pbBlockSize = m_pbRawBlock->ByteSizeLong();
+    if (encodedTxs.empty() && encodedReceipts.empty())
+    {
+        _encodedData.resize(pbBlockSize);
+        m_pbRawBlock->SerializeWithCachedSizesToArray(_encodedData.data());
+        return;
+    }
+    // size the output once and serialize m_pbRawBlock into its tail, then move the fields before
+    // the transactions and the receipts forward and write the transactions and the receipts into
+    // the gaps, so the output is the same as serializing the block with all the fields
+    auto txsTag = WireFormatLite::MakeTag(
+        PBRawBlock::kTransactionsFieldNumber, WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+    auto receiptsTag = WireFormatLite::MakeTag(
+        PBRawBlock::kReceiptsFieldNumber, WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+    auto txsSize = lengthDelimitedFieldsSize(txsTag, encodedTxs);
+    auto receiptsSize = lengthDelimitedFieldsSize(receiptsTag, encodedReceipts);
+    _encodedData.resize(txsSize + receiptsSize + pbBlockSize);
+    auto pbBlockData = _encodedData.data() + txsSize + receiptsSize;
+    m_pbRawBlock->SerializeWithCachedSizesToArray(pbBlockData);
+
+    // the unknown fields are serialized behind all the known fields, only the known fields are
+    // searched for the offsets
+    auto unknownFieldsSize = WireFormat::ComputeUnknownFieldsSize(
+        m_pbRawBlock->GetReflection()->GetUnknownFields(*m_pbRawBlock));
+    auto pbBlockRef = bytesConstRef(pbBlockData, pbBlockSize - unknownFieldsSize);
+    auto txsOffset = fieldsOffset(pbBlockRef, PBRawBlock::kTransactionsFieldNumber);
+    auto receiptsOffset = fieldsOffset(pbBlockRef, PBRawBlock::kReceiptsFieldNumber);
+    auto target = _encodedData.data();
+    memmove(target, pbBlockData, txsOffset);
+    target = writeLengthDelimitedFields(txsTag, encodedTxs, target + txsOffset);
+    memmove(target, pbBlockData + txsOffset, receiptsOffset - txsOffset);
+    // the fields behind the receipts and the unknown fields are already in place
+    writeLengthDelimitedFields(receiptsTag, encodedReceipts, target + receiptsOffset - txsOffset);
 }
 
 void PBBlock::decodeTransactionsMetaData()
@@ -99,22 +176,26 @@ void PBBlock::decodeTransactionsMetaData()
         m_transactionMetaDataList->push_back(std::make_shared<PBTransactionMetaData>(pbTxMetaData));
     }
 }
-void PBBlock::decodeNonceList()
+void PBBlock::decodeNonceList() const
 {
     auto noncesNum = m_pbRawBlock->noncelist_size();
     if (noncesNum == 0)
     {
         return;
     }
-    // decode the transactionsHash
+    // decode the nonces in parallel
     m_nonceList->clear();
-    for (auto i = 0; i < noncesNum; i++)
-    {
-        auto const& nonceData = m_pbRawBlock->noncelist(i);
-        auto nonceValue =
-            fromBigEndian<u256>(bytesConstRef((const byte*)nonceData.data(), nonceData.size()));
-        m_nonceList->push_back(nonceValue);
-    }
+    m_nonceList->resize(noncesNum);
+    tbb::parallel_for(
+        tbb::blocked_range<int>(0, noncesNum), [&](const tbb::blocked_range<int>& _r) {
+            for (auto i = _r.begin(); i < _r.end(); i++)
+            {
+                auto const& nonceData = m_pbRawBlock->noncelist(i);
+                auto nonceBegin = (byte const*)nonceData.data();
+                boost::multiprecision::import_bits(
+                    (*m_nonceList)[i], nonceBegin, nonceBegin + nonceData.size(), 8);
+            }
+        });
 }
 
 void PBBlock::decodeTransactions(bool _calculateHash, bool _checkSig)
@@ -168,61 +249,80 @@ void PBBlock::decodeReceipts(bool _calculateHash)
         });
 }
 
-void PBBlock::encodeTransactions() const
+void PBBlock::encodeTransactions(std::vector<bytesConstRef>& _encodedTxs) const
 {
-    auto txsNum = m_transactions->size();
-    if (txsNum == 0)
-    {
-        return;
-    }
     // hit the transaction cache
     if (m_pbRawBlock->transactions_size() > 0)
     {
         return;
     }
-    // extend transactions
-    for (size_t i = 0; i < txsNum; i++)
-    {
-        m_pbRawBlock->add_transactions();
-    }
-    // parallel encode transactions
-    tbb::parallel_for(tbb::blocked_range<int>(0, txsNum), [&](const tbb::blocked_range<int>& _r) {
-        for (auto i = _r.begin(); i < _r.end(); i++)
-        {
-            auto data = (*m_transactions)[i]->encode(false);
-            m_pbRawBlock->set_transactions(i, data.data(), data.size());
-        }
-    });
+    // the transactions cache their own encoded data, refer to it without copying
+    _encodedTxs.resize(m_transactions->size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, _encodedTxs.size()),
+        [&](const tbb::blocked_range<size_t>& _r) {
+            for (auto i = _r.begin(); i < _r.end(); i++)
+            {
+                _encodedTxs[i] = (*m_transactions)[i]->encode(false);
+            }
+        });
 }
-void PBBlock::encodeReceipts() const
+
+void PBBlock::encodeReceipts(std::vector<bytesConstRef>& _encodedReceipts) const
 {
-    auto receiptsNum = m_receipts->size();
-    if (receiptsNum == 0)
-    {
-        return;
-    }
     // hit the receipts cache
     if (m_pbRawBlock->receipts_size() > 0)
     {
         return;
     }
-    // extend transactions
-    for (size_t i = 0; i < receiptsNum; i++)
-    {
-        m_pbRawBlock->add_receipts();
-    }
-    // parallel encode transactions
-    tbb::parallel_for(
-        tbb::blocked_range<int>(0, receiptsNum), [&](const tbb::blocked_range<int>& _r) {
+    _encodedReceipts.resize(m_receipts->size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, _encodedReceipts.size()),
+        [&](const tbb::blocked_range<size_t>& _r) {
             for (auto i = _r.begin(); i < _r.end(); i++)
             {
-                auto encodedData = std::make_shared<bytes>();
-                (*m_receipts)[i]->encode(*encodedData);
-                m_pbRawBlock->set_receipts(i, encodedData->data(), encodedData->size());
+                _encodedReceipts[i] = (*m_receipts)[i]->encode(false);
             }
         });
 }
 
+size_t PBBlock::lengthDelimitedFieldsSize(
+    uint32_t _tag, std::vector<bytesConstRef> const& _fields)
+{
+    size_t fieldsSize = 0;
+    auto tagSize = CodedOutputStream::VarintSize32(_tag);
+    for (auto const& field : _fields)
+    {
+        fieldsSize += tagSize + CodedOutputStream::VarintSize32(field.size()) + field.size();
+    }
+    return fieldsSize;
+}
+
+size_t PBBlock::fieldsOffset(bytesConstRef _encodedData, int _fieldNumber)
+{
+    CodedInputStream stream(_encodedData.data(), _encodedData.size());
+    while (true)
+    {
+        auto offset = stream.CurrentPosition();
+        auto tag = stream.ReadTag();
+        if (tag == 0 || WireFormatLite::GetTagFieldNumber(tag) > _fieldNumber)
+        {
+            return tag == 0 ? _encodedData.size() : offset;
+        }
+        WireFormatLite::SkipField(&stream, tag);
+    }
+}
+
+byte* PBBlock::writeLengthDelimitedFields(
+    uint32_t _tag, std::vector<bytesConstRef> const& _fields, byte* _target)
+{
+    for (auto const& field : _fields)
+    {
+        _target = CodedOutputStream::WriteTagToArray(_tag, _target);
+        _target = CodedOutputStream::WriteVarint32ToArray(field.size(), _target);
+        _target = CodedOutputStream::WriteRawToArray(field.data(), field.size(), _target);
+    }
+    return _target;
+}
+
 void PBBlock::encodeTransactionsMetaData() const
 {
     clearTransactionMetaDataCache();
@@ -245,24 +345,49 @@ void PBBlock::encodeNonceList() const
     {
         return;
     }
+    // every nonce is encoded into the fixed-width 32-bytes big-endian data
+    m_pbRawBlock->mutable_noncelist()->Reserve(nonceNum);
     for (size_t i = 0; i < nonceNum; i++)
     {
-        m_pbRawBlock->add_noncelist();
+        m_pbRawBlock->add_noncelist()->resize(c_nonceSize);
     }
-    int index = 0;
-    for (auto const& nonce : *m_nonceList)
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, nonceNum), [&](const tbb::blocked_range<size_t>& _r) {
+            std::array<byte, c_nonceSize> buffer;
+            for (auto i = _r.begin(); i < _r.end(); i++)
+            {
+                // only the significant bytes are exported, padding with zero in the front
+                auto end = boost::multiprecision::export_bits((*m_nonceList)[i], buffer.data(), 8);
+                size_t significantSize = end - buffer.data();
+                auto nonceData = (byte*)m_pbRawBlock->mutable_noncelist(i)->data();
+                memset(nonceData, 0, c_nonceSize - significantSize);
+                memcpy(nonceData + c_nonceSize - significantSize, buffer.data(), significantSize);
+            }
+        });
+}
+
+NonceListConstPtr PBBlock::cachedNonces() const
+{
+    UpgradableGuard l(x_nonces);
+    if (m_nonces)
     {
-        auto nonceBytes = toBigEndian(nonce);
-        m_pbRawBlock->set_noncelist(index++, nonceBytes.data(), nonceBytes.size());
+        return m_nonces;
     }
+    UpgradeGuard ul(l);
+    m_nonces = Block::nonces();
+    return m_nonces;
 }
 
 Transaction::ConstPtr PBBlock::transaction(size_t _index) const
 {
-    if (m_transactions->size() < _index)
+    if (m_transactions->size() <= _index)
     {
         return nullptr;
     }
+    if (m_lazyTransactions)
+    {
+        return decodeLazyTransaction(_index);
+    }
     return (*m_transactions)[_index];
 }
 
@@ -277,9 +402,248 @@ TransactionMetaData::ConstPtr PBBlock::transactionMetaData(size_t _index) const
 
 TransactionReceipt::ConstPtr PBBlock::receipt(size_t _index) const
 {
-    if (m_receipts->size() < _index)
+    if (m_receipts->size() <= _index)
     {
         return nullptr;
     }
+    if (m_lazyReceipts)
+    {
+        return decodeLazyReceipt(_index);
+    }
     return (*m_receipts)[_index];
 }
+
+void PBBlock::decodeLazyBlockHeader() const
+{
+    if (!m_lazyBlockHeader)
+    {
+        return;
+    }
+    WriteGuard l(x_lazyBlockHeader);
+    if (!m_lazyBlockHeader)
+    {
+        return;
+    }
+    auto const& blockHeaderData = m_pbRawBlock->header();
+    m_blockHeader = m_blockHeaderFactory->createBlockHeader(
+        bytesConstRef((byte const*)blockHeaderData.data(), blockHeaderData.size()));
+    m_lazyBlockHeader = false;
+}
+
+void PBBlock::decodeLazyNonceList() const
+{
+    if (!m_lazyNonceList)
+    {
+        return;
+    }
+    WriteGuard l(x_lazyNonceList);
+    if (!m_lazyNonceList)
+    {
+        return;
+    }
+    decodeNonceList();
+    m_lazyNonceList = false;
+}
+
+Transaction::Ptr PBBlock::decodeLazyTransaction(size_t _index) const
+{
+    {
+        ReadGuard l(x_lazyTransactions);
+        auto transaction = (*m_transactions)[_index];
+        if (transaction)
+        {
+            return transaction;
+        }
+    }
+    // decode outside the lock, so the transactions can be decoded in parallel
+    auto const& txData = m_pbRawBlock->transactions(_index);
+    auto transaction = m_transactionFactory->createTransaction(
+        bytesConstRef((byte const*)txData.data(), txData.size()), m_checkSig);
+    if (m_calculateHash)
+    {
+        transaction->hash();
+    }
+    WriteGuard l(x_lazyTransactions);
+    auto& cachedTransaction = (*m_transactions)[_index];
+    // the transaction may have been decoded by the other thread
+    if (!cachedTransaction)
+    {
+        cachedTransaction = transaction;
+    }
+    return cachedTransaction;
+}
+
+TransactionReceipt::Ptr PBBlock::decodeLazyReceipt(size_t _index) const
+{
+    {
+        ReadGuard l(x_lazyReceipts);
+        auto receipt = (*m_receipts)[_index];
+        if (receipt)
+        {
+            return receipt;
+        }
+    }
+    auto const& receiptData = m_pbRawBlock->receipts(_index);
+    auto receipt = m_receiptFactory->createReceipt(
+        bytesConstRef((byte const*)receiptData.data(), receiptData.size()));
+    if (m_calculateHash)
+    {
+        receipt->hash();
+    }
+    WriteGuard l(x_lazyReceipts);
+    auto& cachedReceipt = (*m_receipts)[_index];
+    if (!cachedReceipt)
+    {
+        cachedReceipt = receipt;
+    }
+    return cachedReceipt;
+}
+
+void PBBlock::decodeLazyTransactions() const
+{
+    if (!m_lazyTransactions)
+    {
+        return;
+    }
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, m_transactions->size()),
+        [&](const tbb::blocked_range<size_t>& _r) {
+            for (auto i = _r.begin(); i < _r.end(); i++)
+            {
+                decodeLazyTransaction(i);
+            }
+        });
+    m_lazyTransactions = false;
+}
+
+void PBBlock::decodeLazyReceipts() const
+{
+    if (!m_lazyReceipts)
+    {
+        return;
+    }
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, m_receipts->size()),
+        [&](const tbb::blocked_range<size_t>& _r) {
+            for (auto i = _r.begin(); i < _r.end(); i++)
+            {
+                decodeLazyReceipt(i);
+            }
+        });
+    m_lazyReceipts = false;
+}
+
+template <class ReadFunc>
+auto PBBlock::readTransactionsMerkleTree(ReadFunc _readFunc) const
+{
+    {
+        ReadGuard l(x_txsMerkleTree);
+        if (m_txsMerkleTree)
+        {
+            return _readFunc(*m_txsMerkleTree);
+        }
+    }
+    WriteGuard l(x_txsMerkleTree);
+    if (!m_txsMerkleTree)
+    {
+        auto leaves = encodeTransactionsToCalculateRoot();
+        m_txsMerkleTree = std::make_shared<MerkleTree>(
+            m_transactionFactory->cryptoSuite()->hashImpl(), ref(leaves), c_merkleLeafSize);
+    }
+    return _readFunc(*m_txsMerkleTree);
+}
+
+template <class ReadFunc>
+auto PBBlock::readReceiptsMerkleTree(ReadFunc _readFunc) const
+{
+    {
+        ReadGuard l(x_receiptsMerkleTree);
+        if (m_receiptsMerkleTree)
+        {
+            return _readFunc(*m_receiptsMerkleTree);
+        }
+    }
+    WriteGuard l(x_receiptsMerkleTree);
+    if (!m_receiptsMerkleTree)
+    {
+        auto leaves = encodeReceiptsToCalculateRoot();
+        m_receiptsMerkleTree = std::make_shared<MerkleTree>(
+            m_receiptFactory->cryptoSuite()->hashImpl(), ref(leaves), c_merkleLeafSize);
+    }
+    return _readFunc(*m_receiptsMerkleTree);
+}
+
+HashType PBBlock::calculateTransactionRoot() const
+{
+    // with no transactions
+    if (transactionsSize() == 0 && transactionsMetaDataSize() == 0)
+    {
+        return HashType();
+    }
+    return readTransactionsMerkleTree([](MerkleTree const& _tree) { return _tree.root(); });
+}
+
+HashType PBBlock::calculateReceiptRoot() const
+{
+    // with no receipts
+    if (receiptsSize() == 0)
+    {
+        return HashType();
+    }
+    return readReceiptsMerkleTree([](MerkleTree const& _tree) { return _tree.root(); });
+}
+
+MerkleProof PBBlock::transactionProof(size_t _index) const
+{
+    return readTransactionsMerkleTree(
+        [_index](MerkleTree const& _tree) { return _tree.generateProof(_index); });
+}
+
+MerkleProof PBBlock::receiptProof(size_t _index) const
+{
+    return readReceiptsMerkleTree(
+        [_index](MerkleTree const& _tree) { return _tree.generateProof(_index); });
+}
+
+void PBBlock::updateTransactionsMerkleTree(
+    size_t _index, bcos::crypto::HashType const& _hash, size_t _leavesSize)
+{
+    WriteGuard l(x_txsMerkleTree);
+    if (!m_txsMerkleTree)
+    {
+        return;
+    }
+    auto leavesSize = m_txsMerkleTree->leavesSize();
+    if (_index < leavesSize && leavesSize == _leavesSize)
+    {
+        m_txsMerkleTree->updateLeaf(_index, encodeMerkleLeaf(_index, _hash));
+        return;
+    }
+    if (_index == leavesSize && leavesSize + 1 == _leavesSize)
+    {
+        m_txsMerkleTree->appendLeaf(encodeMerkleLeaf(_index, _hash));
+        return;
+    }
+    // the cached tree mismatches with the transactions, rebuild when required
+    m_txsMerkleTree = nullptr;
+}
+
+void PBBlock::updateReceiptsMerkleTree(size_t _index, bcos::crypto::HashType const& _hash)
+{
+    WriteGuard l(x_receiptsMerkleTree);
+    if (!m_receiptsMerkleTree)
+    {
+        return;
+    }
+    auto leavesSize = m_receiptsMerkleTree->leavesSize();
+    auto receiptsSize = m_receipts->size();
+    if (_index < leavesSize && leavesSize == receiptsSize)
+    {
+        m_receiptsMerkleTree->updateLeaf(_index, encodeMerkleLeaf(_index, _hash));
+        return;
+    }
+    if (_index == leavesSize && leavesSize + 1 == receiptsSize)
+    {
+        m_receiptsMerkleTree->appendLeaf(encodeMerkleLeaf(_index, _hash));
+        return;
+    }
+    m_receiptsMerkleTree = nullptr;
+}
@@ -23,6 +23,7 @@
 #include "../../interfaces/protocol/Block.h"
 #include "../../interfaces/protocol/BlockHeaderFactory.h"
 #include "../../interfaces/protocol/TransactionMetaData.h"
+#include "../MerkleTree.h"
 #include "libprotocol/bcos-proto/Block.pb.h"
 namespace bcos
 {
@@ -31,6 +32,8 @@ namespace protocol
 class PBBlock : public Block
 {
 public:
+    // the size of the big-endian encoded nonce
+    static constexpr size_t c_nonceSize = 32;
     using Ptr = std::shared_ptr<PBBlock>;
     PBBlock(BlockHeaderFactory::Ptr _blockHeaderFactory,
         TransactionFactory::Ptr _transactionFactory, TransactionReceiptFactory::Ptr _receiptFactory)
@@ -69,6 +72,9 @@ public:
     }
 
     void decode(bytesConstRef _data, bool _calculateHash, bool _checkSig) override;
+    // only parse the raw block, the blockHeader, the transactions, the receipts and the nonceList
+    // are decoded on the first access
+    void decodeLazily(bytesConstRef _data, bool _calculateHash, bool _checkSig);
     void encode(bytes& _encodeData) const override;
 
     // getNonces of the current block
@@ -83,12 +89,28 @@ public:
 
     BlockType blockType() const override { return (BlockType)m_pbRawBlock->type(); }
     // get blockHeader
-    BlockHeader::ConstPtr blockHeaderConst() const override { return m_blockHeader; }
-    BlockHeader::Ptr blockHeader() override { return m_blockHeader; }
+    BlockHeader::ConstPtr blockHeaderConst() const override
+    {
+        decodeLazyBlockHeader();
+        return m_blockHeader;
+    }
+    BlockHeader::Ptr blockHeader() override
+    {
+        decodeLazyBlockHeader();
+        return m_blockHeader;
+    }
     // get transactions
-    TransactionsConstPtr transactions() const { return m_transactions; }  // removed
+    TransactionsConstPtr transactions() const
+    {
+        decodeLazyTransactions();
+        return m_transactions;
+    }  // removed
     // get receipts
-    ReceiptsConstPtr receipts() const { return m_receipts; }  // removed
+    ReceiptsConstPtr receipts() const
+    {
+        decodeLazyReceipts();
+        return m_receipts;
+    }  // removed
     // get transaction hash
     TransactionMetaDataList const& transactionsMetaData() const
     {
@@ -100,54 +122,78 @@ public:
         m_pbRawBlock->set_type((int32_t)_blockType);
     }
     // set blockHeader
-    void setBlockHeader(BlockHeader::Ptr _blockHeader) override { m_blockHeader = _blockHeader; }
+    void setBlockHeader(BlockHeader::Ptr _blockHeader) override
+    {
+        m_blockHeader = _blockHeader;
+        m_lazyBlockHeader = false;
+    }
     // set transactions
     void setTransactions(TransactionsPtr _transactions)  // removed
     {
         m_transactions = _transactions;
+        m_lazyTransactions = false;
         clearTransactionsCache();
+        resetTransactionsMerkleTree();
     }
     // Note: the caller must ensure the allocated transactions size
     void setTransaction(size_t _index, Transaction::Ptr _transaction) override
     {
+        // the raw transactions are cleared after the update
+        decodeLazyTransactions();
         if (m_transactions->size() <= _index)
         {
             m_transactions->resize(_index + 1);
         }
         (*m_transactions)[_index] = _transaction;
         clearTransactionsCache();
+        updateTransactionsMerkleTree(_index, _transaction->hash(), m_transactions->size());
     }
     void appendTransaction(Transaction::Ptr _transaction) override
     {
+        decodeLazyTransactions();
         m_transactions->push_back(_transaction);
         clearTransactionsCache();
+        updateTransactionsMerkleTree(
+            m_transactions->size() - 1, _transaction->hash(), m_transactions->size());
     }
     // set receipts
     void setReceipts(ReceiptsPtr _receipts)  // removed
     {
         m_receipts = _receipts;
+        m_lazyReceipts = false;
         // clear the cache
         clearReceiptsCache();
+        resetReceiptsMerkleTree();
     }
     // Note: the caller must ensure the allocated receipts size
     void setReceipt(size_t _index, TransactionReceipt::Ptr _receipt) override
     {
+        decodeLazyReceipts();
         if (m_receipts->size() <= _index)
         {
             m_receipts->resize(_index + 1);
         }
         (*m_receipts)[_index] = _receipt;
         clearReceiptsCache();
+        updateReceiptsMerkleTree(_index, _receipt->hash());
     }
 
     void appendReceipt(TransactionReceipt::Ptr _receipt) override
     {
+        decodeLazyReceipts();
         m_receipts->push_back(_receipt);
         clearReceiptsCache();
+        updateReceiptsMerkleTree(m_receipts->size() - 1, _receipt->hash());
     }
     void appendTransactionMetaData(TransactionMetaData::Ptr _txMetaData) override
     {
         m_transactionMetaDataList->emplace_back(_txMetaData);
+        // the txsRoot is calculated from the metaData only when without transactions
+        if (m_transactions->empty())
+        {
+            updateTransactionsMerkleTree(m_transactionMetaDataList->size() - 1,
+                _txMetaData->hash(), m_transactionMetaDataList->size());
+        }
     }
 
     // get transactions size
@@ -159,15 +205,33 @@ public:
     void setNonceList(NonceList const& _nonceList) override
     {
         *m_nonceList = _nonceList;
+        m_lazyNonceList = false;
         m_pbRawBlock->clear_noncelist();
     }
 
     void setNonceList(NonceList&& _nonceList) override
     {
         *m_nonceList = std::move(_nonceList);
+        m_lazyNonceList = false;
         m_pbRawBlock->clear_noncelist();
     }
-    NonceList const& nonceList() const override { return *m_nonceList; }
+    // the nonces of the transactions are cached until the transactions are updated
+    // the returned nonces are shared by all the callers and immutable
+    // the nonces are cached until the transactions are updated
+    NonceListConstPtr cachedNonces() const override;
+    NonceListPtr nonces() const override { return std::make_shared<NonceList>(*cachedNonces()); }
+    NonceList const& nonceList() const override
+    {
+        decodeLazyNonceList();
+        return *m_nonceList;
+    }
+
+    // the roots are calculated from the cached merkle trees
+    bcos::crypto::HashType calculateTransactionRoot() const override;
+    bcos::crypto::HashType calculateReceiptRoot() const override;
+    // the proofs of the _index-th transaction and receipt, generated from the cached merkle trees
+    MerkleProof transactionProof(size_t _index) const;
+    MerkleProof receiptProof(size_t _index) const;
 
 protected:
     virtual void encodeTransactionsMetaData() const;
@@ -187,16 +251,32 @@ private:
     void decodeTransactions(bool _calculateHash, bool _checkSig);
     void decodeReceipts(bool _calculateHash);
 
-    void decodeNonceList();
+    void decodeNonceList() const;
+
+    // decode the fields of the lazily decoded block on the first access
+    void decodeLazyBlockHeader() const;
+    void decodeLazyTransactions() const;
+    void decodeLazyReceipts() const;
+    void decodeLazyNonceList() const;
+    Transaction::Ptr decodeLazyTransaction(size_t _index) const;
+    TransactionReceipt::Ptr decodeLazyReceipt(size_t _index) const;
 
-    void encodeTransactions() const;
-    void encodeReceipts() const;
+    // collect the encoded transactions and receipts that are not cached in m_pbRawBlock
+    void encodeTransactions(std::vector<bytesConstRef>& _encodedTxs) const;
+    void encodeReceipts(std::vector<bytesConstRef>& _encodedReceipts) const;
+    static size_t lengthDelimitedFieldsSize(
+        uint32_t _tag, std::vector<bytesConstRef> const& _fields);
+    // the offset of the first field whose number is larger than _fieldNumber
+    static size_t fieldsOffset(bytesConstRef _encodedData, int _fieldNumber);
+    static byte* writeLengthDelimitedFields(
+        uint32_t _tag, std::vector<bytesConstRef> const& _fields, byte* _target);
 
     void encodeNonceList() const;
 
     void clearTransactionsCache()
     {
         m_pbRawBlock->clear_transactions();
+        resetNonces();
         // WriteGuard l(x_txsRootCache);
         // m_txsRootCache = bcos::crypto::HashType();
     }
@@ -207,14 +287,60 @@ private:
         // m_receiptRootCache = bcos::crypto::HashType();
     }
 
+    // update the cached merkle tree in place with the _index-th leaf, only the path from the leaf
+    // to the top is rehashed in O(log16(n)), _leavesSize is the expected leaves size after update
+    void updateTransactionsMerkleTree(
+        size_t _index, bcos::crypto::HashType const& _hash, size_t _leavesSize);
+    void updateReceiptsMerkleTree(size_t _index, bcos::crypto::HashType const& _hash);
+    void resetNonces()
+    {
+        WriteGuard l(x_nonces);
+        m_nonces = nullptr;
+    }
+    // run _readFunc on the cached merkle tree under the read lock, build the tree if required
+    template <class ReadFunc>
+    auto readTransactionsMerkleTree(ReadFunc _readFunc) const;
+    template <class ReadFunc>
+    auto readReceiptsMerkleTree(ReadFunc _readFunc) const;
+    void resetTransactionsMerkleTree()
+    {
+        WriteGuard l(x_txsMerkleTree);
+        m_txsMerkleTree = nullptr;
+    }
+    void resetReceiptsMerkleTree()
+    {
+        WriteGuard l(x_receiptsMerkleTree);
+        m_receiptsMerkleTree = nullptr;
+    }
+
 private:
     BlockHeaderFactory::Ptr m_blockHeaderFactory;
     std::shared_ptr<PBRawBlock> m_pbRawBlock;
-    BlockHeader::Ptr m_blockHeader;
+    mutable BlockHeader::Ptr m_blockHeader;
     TransactionsPtr m_transactions;
     ReceiptsPtr m_receipts;
     TransactionMetaDataListPtr m_transactionMetaDataList;
     NonceListPtr m_nonceList;
+
+    mutable NonceListConstPtr m_nonces;
+    mutable SharedMutex x_nonces;
+    // the cached merkle trees are only accessed under the locks and never handed out
+    mutable MerkleTree::Ptr m_txsMerkleTree;
+    mutable SharedMutex x_txsMerkleTree;
+    mutable MerkleTree::Ptr m_receiptsMerkleTree;
+    mutable SharedMutex x_receiptsMerkleTree;
+
+    // the fields that have not been decoded from m_pbRawBlock of the lazily decoded block
+    mutable std::atomic_bool m_lazyBlockHeader = {false};
+    mutable SharedMutex x_lazyBlockHeader;
+    mutable std::atomic_bool m_lazyTransactions = {false};
+    mutable SharedMutex x_lazyTransactions;
+    mutable std::atomic_bool m_lazyReceipts = {false};
+    mutable SharedMutex x_lazyReceipts;
+    mutable std::atomic_bool m_lazyNonceList = {false};
+    mutable SharedMutex x_lazyNonceList;
+    bool m_calculateHash = true;
+    bool m_checkSig = true;
 };
 }  // namespace protocol
 }  // namespace bcos
\ No newline at end of file
@@ -62,6 +62,15 @@ public:
             m_receiptFactory, _data, _calculateHash, _checkSig);
     }
 
+    Block::Ptr createBlockLazily(
+        bytesConstRef _data, bool _calculateHash = true, bool _checkSig = true) override
+    {
+        auto block =
+            std::make_shared<PBBlock>(m_blockHeaderFactory, m_transactionFactory, m_receiptFactory);
+        block->decodeLazily(_data, _calculateHash, _checkSig);
+        return block;
+    }
+
     TransactionMetaData::Ptr createTransactionMetaData() override
     {
         return std::make_shared<PBTransactionMetaData>();
@@ -35,8 +35,9 @@ void PBBlockHeader::decode(bytesConstRef _data)
     auto hashFieldsPtr = m_blockHeader->mutable_hashfieldsdata();
     ScaleDecoderStream stream(
         gsl::span<byte const>((byte*)hashFieldsPtr->data(), hashFieldsPtr->size()));
-    stream >> m_parentInfo >> m_txsRoot >> m_receiptsRoot >> m_stateRoot >> m_number >> m_gasUsed >>
-        m_timestamp >> m_sealer >> m_sealerList >> m_consensusWeights >> m_extraData;
+    // the fixed fields from the txsRoot to the sealer are decoded with one bounds check
+    stream >> makeFieldList(m_parentInfo, m_txsRoot, m_receiptsRoot, m_stateRoot, m_number,
+                  m_gasUsed, m_timestamp, m_sealer, m_sealerList, m_consensusWeights, m_extraData);
 
     // decode signatureList
     for (int i = 0; i < m_blockHeader->signaturelist_size(); i++)
@@ -57,11 +58,10 @@ void PBBlockHeader::encodeHashFields() const
     {
         return;
     }
-    ScaleEncoderStream stream;
-    stream << m_parentInfo << m_txsRoot << m_receiptsRoot << m_stateRoot << m_number << m_gasUsed
-           << m_timestamp << m_sealer << m_sealerList << m_consensusWeights << m_extraData;
-    auto hashFieldsData = stream.data();
-    m_blockHeader->set_hashfieldsdata(hashFieldsData.data(), hashFieldsData.size());
+    // encode the hashFieldsData into the pb field directly
+    encodeTo(*m_blockHeader->mutable_hashfieldsdata(),
+        makeFieldList(m_parentInfo, m_txsRoot, m_receiptsRoot, m_stateRoot, m_number, m_gasUsed,
+            m_timestamp, m_sealer, m_sealerList, m_consensusWeights, m_extraData));
 }
 
 void PBBlockHeader::encodeSignatureList() const
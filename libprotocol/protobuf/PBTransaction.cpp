@@ -21,12 +21,13 @@
 #include "PBTransaction.h"
 #include "../../interfaces/protocol/Exceptions.h"
 #include "../Common.h"
+#include "../TransactionSenderCache.h"
 
 using namespace bcos;
 using namespace bcos::protocol;
 using namespace bcos::crypto;
 
-PBTransaction::PBTransaction(bcos::crypto::CryptoSuite::Ptr _cryptoSuite, int32_t _version,
+PBTransaction::PBTransaction(bcos::crypto::CryptoSuite::Ptr const& _cryptoSuite, int32_t _version,
     const std::string_view& _to, bytes const& _input, u256 const& _nonce, int64_t _blockLimit,
     std::string const& _chainId, std::string const& _groupId, int64_t _importTime)
   : PBTransaction(_cryptoSuite)
@@ -59,7 +60,8 @@ PBTransaction::PBTransaction(bcos::crypto::CryptoSuite::Ptr _cryptoSuite, int32_
     m_transaction->set_import_time(_importTime);
 }
 
-PBTransaction::PBTransaction(CryptoSuite::Ptr _cryptoSuite, bytesConstRef _txData, bool _checkSig)
+PBTransaction::PBTransaction(
+    CryptoSuite::Ptr const& _cryptoSuite, bytesConstRef _txData, bool _checkSig)
   : PBTransaction(_cryptoSuite)
 {
     decode(_txData);
@@ -72,7 +74,7 @@ PBTransaction::PBTransaction(CryptoSuite::Ptr _cryptoSuite, bytesConstRef _txDat
 void PBTransaction::decode(bytesConstRef _txData)
 {
     // cache data into dataCache
-    *m_dataCache = _txData.toBytes();
+    m_dataCache->assign(_txData.begin(), _txData.end());
     // decode transaction
     decodePBObject(m_transaction, _txData);
     // decode transactionHashFields
@@ -103,6 +105,28 @@ bytesConstRef PBTransaction::encode(bool _onlyHashFields) const
     return bytesConstRef((byte const*)m_dataCache->data(), m_dataCache->size());
 }
 
+void PBTransaction::reset()
+{
+    m_transaction->Clear();
+    m_transactionHashFields->Clear();
+    m_dataCache->clear();
+    m_nonce = 0;
+    Transaction::reset();
+}
+
+void PBTransaction::recoverSender(HashType const& _hash, bytesConstRef _signature) const
+{
+    auto& senderCache = TransactionSenderCache::instance();
+    bytes cachedSender;
+    if (senderCache.get(_hash, _signature, cachedSender))
+    {
+        forceSender(std::move(cachedSender));
+        return;
+    }
+    Transaction::recoverSender(_hash, _signature);
+    senderCache.insert(_hash, _signature, m_sender);
+}
+
 bcos::crypto::HashType PBTransaction::hash() const
 {
     return *(
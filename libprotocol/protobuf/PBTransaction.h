@@ -32,16 +32,19 @@ namespace protocol
 {
 class PBTransaction : public Transaction
 {
+    // create and recycle the pooled transactions
+    friend class PBTransactionFactory;
+
 public:
     using Ptr = std::shared_ptr<PBTransaction>;
-    PBTransaction(bcos::crypto::CryptoSuite::Ptr _cryptoSuite, int32_t _version,
+    PBTransaction(bcos::crypto::CryptoSuite::Ptr const& _cryptoSuite, int32_t _version,
         const std::string_view& _to, bytes const& _input, u256 const& _nonce, int64_t _blockLimit,
         std::string const& _chainId, std::string const& _groupId, int64_t _importTime);
 
     explicit PBTransaction(
-        bcos::crypto::CryptoSuite::Ptr _cryptoSuite, bytesConstRef _txData, bool _checkSig);
+        bcos::crypto::CryptoSuite::Ptr const& _cryptoSuite, bytesConstRef _txData, bool _checkSig);
     explicit PBTransaction(
-        bcos::crypto::CryptoSuite::Ptr _cryptoSuite, bytes const& _txData, bool _checkSig)
+        bcos::crypto::CryptoSuite::Ptr const& _cryptoSuite, bytes const& _txData, bool _checkSig)
       : PBTransaction(_cryptoSuite, &_txData, _checkSig)
     {}
 
@@ -88,7 +91,7 @@ public:
     void setSource(std::string const& _source) override { m_transaction->set_source(_source); }
 
 protected:
-    explicit PBTransaction(bcos::crypto::CryptoSuite::Ptr _cryptoSuite)
+    explicit PBTransaction(bcos::crypto::CryptoSuite::Ptr const& _cryptoSuite)
       : Transaction(_cryptoSuite),
         m_transaction(std::make_shared<PBRawTransaction>()),
         m_transactionHashFields(std::make_shared<PBRawTransactionHashFields>()),
@@ -97,6 +100,13 @@ protected:
         GOOGLE_PROTOBUF_VERIFY_VERSION;
     }
 
+    // clear all the fields and keep the allocated buffers, for reusing the transaction
+    void reset();
+
+    // hit the sender recovered when the tx was verified before(e.g. by the txpool)
+    void recoverSender(
+        bcos::crypto::HashType const& _hash, bytesConstRef _signature) const override;
+
 private:
     void encode(bytes& _encodedData) const;
 
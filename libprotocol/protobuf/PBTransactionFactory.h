@@ -21,6 +21,7 @@
 #pragma once
 #include "../../interfaces/crypto/CryptoSuite.h"
 #include "../../interfaces/protocol/TransactionFactory.h"
+#include "../../libutilities/ObjectPool.h"
 #include "PBTransaction.h"
 #include <memory>
 
@@ -32,21 +33,41 @@ class PBTransactionFactory : public TransactionFactory
 {
 public:
     using Ptr = std::shared_ptr<PBTransactionFactory>;
-    explicit PBTransactionFactory(bcos::crypto::CryptoSuite::Ptr _cryptoSuite)
+    // the decoded transactions are recycled through the pool with the given capacity, 0 means
+    // disable the pool
+    static constexpr size_t c_defaultPoolCapacity = 10000;
+    explicit PBTransactionFactory(
+        bcos::crypto::CryptoSuite::Ptr _cryptoSuite, size_t _poolCapacity = c_defaultPoolCapacity)
     {
         m_cryptoSuite = _cryptoSuite;
+        if (_poolCapacity > 0)
+        {
+            m_pool = std::make_shared<ObjectPool<PBTransaction>>(
+                _poolCapacity, [_cryptoSuite]() { return new PBTransaction(_cryptoSuite); },
+                [](PBTransaction& _tx) { _tx.reset(); });
+        }
     }
 
     ~PBTransactionFactory() override {}
 
     Transaction::Ptr createTransaction(bytesConstRef _txData, bool _checkSig = true) override
     {
-        return std::make_shared<PBTransaction>(m_cryptoSuite, _txData, _checkSig);
+        if (!m_pool)
+        {
+            return std::make_shared<PBTransaction>(m_cryptoSuite, _txData, _checkSig);
+        }
+        auto tx = m_pool->acquire();
+        tx->decode(_txData);
+        if (_checkSig)
+        {
+            tx->verify();
+        }
+        return tx;
     }
 
     Transaction::Ptr createTransaction(bytes const& _txData, bool _checkSig = true) override
     {
-        return std::make_shared<PBTransaction>(m_cryptoSuite, _txData, _checkSig);
+        return createTransaction(ref(_txData), _checkSig);
     }
 
     Transaction::Ptr createTransaction(int32_t _version, const std::string_view& _to,
@@ -74,8 +95,12 @@ public:
 
     bcos::crypto::CryptoSuite::Ptr cryptoSuite() override { return m_cryptoSuite; }
 
+    // the pool of the decoded transactions, nullptr if the pool is disabled
+    ObjectPool<PBTransaction>::Ptr pool() const { return m_pool; }
+
 private:
     bcos::crypto::CryptoSuite::Ptr m_cryptoSuite;
+    ObjectPool<PBTransaction>::Ptr m_pool;
 };
 }  // namespace protocol
 }  // namespace bcos
\ No newline at end of file
@@ -29,14 +29,14 @@ using namespace bcos::crypto;
 using namespace bcos::codec::scale;
 
 PBTransactionReceipt::PBTransactionReceipt(
-    CryptoSuite::Ptr _cryptoSuite, bytesConstRef _receiptData)
+    CryptoSuite::Ptr const& _cryptoSuite, bytesConstRef _receiptData)
   : TransactionReceipt(_cryptoSuite), m_receipt(std::make_shared<PBRawTransactionReceipt>())
 {
     m_dataCache = std::make_shared<bytes>();
     decode(_receiptData);
 }
 
-PBTransactionReceipt::PBTransactionReceipt(CryptoSuite::Ptr _cryptoSuite, int32_t _version,
+PBTransactionReceipt::PBTransactionReceipt(CryptoSuite::Ptr const& _cryptoSuite, int32_t _version,
     u256 const& _gasUsed, const std::string_view& _contractAddress, LogEntriesPtr _logEntries,
     int32_t _status, BlockNumber _blockNumber)
   : TransactionReceipt(_cryptoSuite),
@@ -52,7 +52,7 @@ PBTransactionReceipt::PBTransactionReceipt(CryptoSuite::Ptr _cryptoSuite, int32_
     m_receipt->set_version(_version);
 }
 
-PBTransactionReceipt::PBTransactionReceipt(CryptoSuite::Ptr _cryptoSuite, int32_t _version,
+PBTransactionReceipt::PBTransactionReceipt(CryptoSuite::Ptr const& _cryptoSuite, int32_t _version,
     u256 const& _gasUsed, const std::string_view& _contractAddress, LogEntriesPtr _logEntries,
     int32_t _status, bytes const& _ouptput, BlockNumber _blockNumber)
   : PBTransactionReceipt(
@@ -61,7 +61,7 @@ PBTransactionReceipt::PBTransactionReceipt(CryptoSuite::Ptr _cryptoSuite, int32_
     m_output = _ouptput;
 }
 
-PBTransactionReceipt::PBTransactionReceipt(CryptoSuite::Ptr _cryptoSuite, int32_t _version,
+PBTransactionReceipt::PBTransactionReceipt(CryptoSuite::Ptr const& _cryptoSuite, int32_t _version,
     u256 const& _gasUsed, const std::string_view& _contractAddress, LogEntriesPtr _logEntries,
     int32_t _status, bytes&& _ouptput, BlockNumber _blockNumber)
   : PBTransactionReceipt(
@@ -72,13 +72,46 @@ PBTransactionReceipt::PBTransactionReceipt(CryptoSuite::Ptr _cryptoSuite, int32_
 
 void PBTransactionReceipt::decode(bytesConstRef _data)
 {
-    *m_dataCache = _data.toBytes();
+    m_dataCache->assign(_data.begin(), _data.end());
     // decode receipt
     decodePBObject(m_receipt, _data);
     ScaleDecoderStream stream(gsl::span<const byte>(
         (byte*)m_receipt->hashfieldsdata().data(), m_receipt->hashfieldsdata().size()));
-    stream >> m_status >> m_output >> m_contractAddress >> m_gasUsed >> m_logEntries >>
-        m_blockNumber;
+    // the output borrows the hash fields data of the pb receipt instead of copying it
+    gsl::span<const byte> output;
+    stream >> makeFieldList(
+                  m_status, output, m_contractAddress, m_gasUsed, m_logEntries, m_blockNumber);
+    m_output.clear();
+    m_outputBorrowed = true;
+    m_outputOffset =
+        output.empty() ? 0 : output.data() - (byte const*)m_receipt->hashfieldsdata().data();
+    m_outputSize = output.size();
+}
+
+bytesConstRef PBTransactionReceipt::output() const
+{
+    if (!m_outputBorrowed)
+    {
+        return ref(m_output);
+    }
+    auto const& hashFieldsData = m_receipt->hashfieldsdata();
+    return bytesConstRef((byte const*)hashFieldsData.data() + m_outputOffset, m_outputSize);
+}
+
+void PBTransactionReceipt::reset()
+{
+    m_receipt->Clear();
+    m_dataCache->clear();
+    m_version = 0;
+    m_gasUsed = 0;
+    m_contractAddress.clear();
+    m_logEntries = nullptr;
+    m_status = 0;
+    m_output.clear();
+    m_outputBorrowed = false;
+    m_outputOffset = 0;
+    m_outputSize = 0;
+    m_blockNumber = 0;
 }
 
 void PBTransactionReceipt::encode(bytes& _encodeReceiptData) const
@@ -112,11 +145,10 @@ void PBTransactionReceipt::encodeHashFields() const
     {
         return;
     }
-    // encode the hashFieldsData
-    ScaleEncoderStream stream;
-    stream << m_status << m_output << m_contractAddress << m_gasUsed << m_logEntries
-           << m_blockNumber;
-    auto hashFieldsData = stream.data();
+    // encode the hashFieldsData into the pb field directly
     m_receipt->set_version(m_version);
-    m_receipt->set_hashfieldsdata(hashFieldsData.data(), hashFieldsData.size());
+    auto outputRef = output();
+    auto output = gsl::span<const byte>(outputRef.data(), outputRef.size());
+    encodeTo(*m_receipt->mutable_hashfieldsdata(),
+        makeFieldList(m_status, output, m_contractAddress, m_gasUsed, m_logEntries, m_blockNumber));
 }
\ No newline at end of file
@@ -30,17 +30,22 @@ namespace protocol
 {
 class PBTransactionReceipt : public TransactionReceipt
 {
+    // create and recycle the pooled receipts
+    friend class PBTransactionReceiptFactory;
+
 public:
-    PBTransactionReceipt(bcos::crypto::CryptoSuite::Ptr _cryptoSuite, bytesConstRef _receiptData);
-    PBTransactionReceipt(bcos::crypto::CryptoSuite::Ptr _cryptoSuite, bytes const& _receiptData)
+    PBTransactionReceipt(
+        bcos::crypto::CryptoSuite::Ptr const& _cryptoSuite, bytesConstRef _receiptData);
+    PBTransactionReceipt(
+        bcos::crypto::CryptoSuite::Ptr const& _cryptoSuite, bytes const& _receiptData)
       : PBTransactionReceipt(_cryptoSuite, ref(_receiptData))
     {}
 
-    PBTransactionReceipt(bcos::crypto::CryptoSuite::Ptr _cryptoSuite, int32_t _version,
+    PBTransactionReceipt(bcos::crypto::CryptoSuite::Ptr const& _cryptoSuite, int32_t _version,
         u256 const& _gasUsed, const std::string_view& _contractAddress, LogEntriesPtr _logEntries,
         int32_t _status, bytes const& _output, BlockNumber _blockNumber);
 
-    PBTransactionReceipt(bcos::crypto::CryptoSuite::Ptr _cryptoSuite, int32_t _version,
+    PBTransactionReceipt(bcos::crypto::CryptoSuite::Ptr const& _cryptoSuite, int32_t _version,
         u256 const& _gasUsed, const std::string_view& _contractAddress, LogEntriesPtr _logEntries,
         int32_t _status, bytes&& _output, BlockNumber _blockNumber);
 
@@ -52,7 +57,7 @@ public:
 
     int32_t version() const override { return m_receipt->version(); }
     int32_t status() const override { return m_status; }
-    bytesConstRef output() const override { return ref(m_output); }
+    bytesConstRef output() const override;
     std::string_view contractAddress() const override
     {
         return std::string_view((char*)m_contractAddress.data(), m_contractAddress.size());
@@ -64,8 +69,17 @@ public:
     }
     BlockNumber blockNumber() const override { return m_blockNumber; }
 
+protected:
+    explicit PBTransactionReceipt(bcos::crypto::CryptoSuite::Ptr const& _cryptoSuite)
+      : TransactionReceipt(_cryptoSuite),
+        m_receipt(std::make_shared<PBRawTransactionReceipt>()),
+        m_dataCache(std::make_shared<bytes>())
+    {}
+    // clear all the fields and keep the allocated buffers, for reusing the receipt
+    void reset();
+
 private:
-    PBTransactionReceipt(bcos::crypto::CryptoSuite::Ptr _cryptoSuite, int32_t _version,
+    PBTransactionReceipt(bcos::crypto::CryptoSuite::Ptr const& _cryptoSuite, int32_t _version,
         u256 const& _gasUsed, const std::string_view& _contractAddress, LogEntriesPtr _logEntries,
         int32_t _status, BlockNumber _blockNumber);
     virtual void encodeHashFields() const;
@@ -79,7 +93,13 @@ private:
     bytes m_contractAddress;
     LogEntriesPtr m_logEntries;
     int32_t m_status;
+    // the output of the created receipt
     bytes m_output;
+    // the output of the decoded receipt is borrowed from the hash fields data at the offset, the
+    // view is derived on every access so that it always follows the current hash fields data
+    bool m_outputBorrowed = false;
+    size_t m_outputOffset = 0;
+    size_t m_outputSize = 0;
     BlockNumber m_blockNumber;
 };
 }  // namespace protocol
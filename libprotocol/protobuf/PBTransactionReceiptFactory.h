@@ -22,6 +22,7 @@
 #include "PBTransactionReceipt.h"
 #include "interfaces/crypto/CryptoSuite.h"
 #include "interfaces/protocol/TransactionReceiptFactory.h"
+#include "libutilities/ObjectPool.h"
 
 namespace bcos
 {
@@ -31,19 +32,37 @@ class PBTransactionReceiptFactory : public TransactionReceiptFactory
 {
 public:
     using Ptr = std::shared_ptr<PBTransactionReceiptFactory>;
-    explicit PBTransactionReceiptFactory(bcos::crypto::CryptoSuite::Ptr _cryptoSuite)
+    // the decoded receipts are recycled through the pool with the given capacity, 0 means disable
+    // the pool
+    static constexpr size_t c_defaultPoolCapacity = 10000;
+    explicit PBTransactionReceiptFactory(
+        bcos::crypto::CryptoSuite::Ptr _cryptoSuite, size_t _poolCapacity = c_defaultPoolCapacity)
       : m_cryptoSuite(_cryptoSuite)
-    {}
+    {
+        if (_poolCapacity > 0)
+        {
+            m_pool = std::make_shared<ObjectPool<PBTransactionReceipt>>(
+                _poolCapacity,
+                [_cryptoSuite]() { return new PBTransactionReceipt(_cryptoSuite); },
+                [](PBTransactionReceipt& _receipt) { _receipt.reset(); });
+        }
+    }
     ~PBTransactionReceiptFactory() override {}
 
     TransactionReceipt::Ptr createReceipt(bytes const& _receiptData) override
     {
-        return std::make_shared<PBTransactionReceipt>(m_cryptoSuite, _receiptData);
+        return createReceipt(ref(_receiptData));
     }
 
     TransactionReceipt::Ptr createReceipt(bytesConstRef _receiptData) override
     {
-        return std::make_shared<PBTransactionReceipt>(m_cryptoSuite, _receiptData);
+        if (!m_pool)
+        {
+            return std::make_shared<PBTransactionReceipt>(m_cryptoSuite, _receiptData);
+        }
+        auto receipt = m_pool->acquire();
+        receipt->decode(_receiptData);
+        return receipt;
     }
 
     TransactionReceipt::Ptr createReceipt(u256 const& _gasUsed,
@@ -64,8 +83,12 @@ public:
 
     bcos::crypto::CryptoSuite::Ptr cryptoSuite() override { return m_cryptoSuite; }
 
+    // the pool of the decoded receipts, nullptr if the pool is disabled
+    ObjectPool<PBTransactionReceipt>::Ptr pool() const { return m_pool; }
+
 private:
     bcos::crypto::CryptoSuite::Ptr m_cryptoSuite;
+    ObjectPool<PBTransactionReceipt>::Ptr m_pool;
 };
 }  // namespace protocol
 }  // namespace bcos
\ No newline at end of file
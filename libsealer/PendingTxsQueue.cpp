@@ -0,0 +1,96 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the double-buffered queue of the transactions fetched from the txpool
+ * @file PendingTxsQueue.cpp
+ */
+#include "PendingTxsQueue.h"
+using namespace bcos;
+using namespace bcos::sealer;
+using namespace bcos::crypto;
+using namespace bcos::protocol;
+
+void PendingTxsQueue::append(Block::Ptr _fetchedTxs)
+{
+    auto txsSize = _fetchedTxs->transactionsMetaDataSize();
+    if (txsSize == 0)
+    {
+        return;
+    }
+    Guard l(x_input);
+    // count before the chunk is visible, so that the size never falls below the popped size
+    m_size += txsSize;
+    m_input.emplace_back(TxsChunk{std::move(_fetchedTxs), 0});
+}
+
+bool PendingTxsQueue::swapInput()
+{
+    Guard l(x_input);
+    if (m_input.empty())
+    {
+        return false;
+    }
+    std::swap(m_input, m_output);
+    return true;
+}
+
+size_t PendingTxsQueue::popTo(Block::Ptr _block, size_t _maxTxsSize)
+{
+    Guard l(x_output);
+    size_t poppedSize = 0;
+    while (poppedSize < _maxTxsSize)
+    {
+        if (m_output.empty() && !swapInput())
+        {
+            break;
+        }
+        auto& chunk = m_output.front();
+        auto chunkSize = chunk.txs->transactionsMetaDataSize();
+        for (; chunk.offset < chunkSize && poppedSize < _maxTxsSize; chunk.offset++)
+        {
+            _block->appendTransactionMetaData(std::const_pointer_cast<TransactionMetaData>(
+                chunk.txs->transactionMetaData(chunk.offset)));
+            poppedSize++;
+        }
+        if (chunk.offset == chunkSize)
+        {
+            m_output.pop_front();
+        }
+    }
+    m_size -= poppedSize;
+    return poppedSize;
+}
+
+HashListPtr PendingTxsQueue::clear()
+{
+    std::deque<TxsChunk> chunks;
+    {
+        Guard outputLock(x_output);
+        Guard inputLock(x_input);
+        chunks.swap(m_output);
+        chunks.insert(chunks.end(), m_input.begin(), m_input.end());
+        m_input.clear();
+    }
+    auto txsHash = std::make_shared<HashList>();
+    for (auto const& chunk : chunks)
+    {
+        for (auto i = chunk.offset; i < chunk.txs->transactionsMetaDataSize(); i++)
+        {
+            txsHash->emplace_back(chunk.txs->transactionMetaData(i)->hash());
+        }
+    }
+    m_size -= txsHash->size();
+    return txsHash;
+}
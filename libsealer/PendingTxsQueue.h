@@ -0,0 +1,72 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the double-buffered queue of the transactions fetched from the txpool
+ * @file PendingTxsQueue.h
+ */
+#pragma once
+#include "../interfaces/crypto/CommonType.h"
+#include "../interfaces/protocol/Block.h"
+#include <atomic>
+#include <deque>
+
+namespace bcos
+{
+namespace sealer
+{
+/**
+ * @brief the fetched blocks are queued as chunks without copying the transactions
+ *        the fetcher appends the chunks to the input buffer, the sealer takes the transactions
+ *        from the output buffer and swaps the two buffers in O(1) when the output buffer is
+ *        drained, so that fetching only contends with sealing on the swap
+ *        note: popTo still appends the taken transactions to the block one by one
+ */
+class PendingTxsQueue
+{
+public:
+    using Ptr = std::shared_ptr<PendingTxsQueue>;
+    PendingTxsQueue() = default;
+    virtual ~PendingTxsQueue() {}
+
+    // append all the transactions of the fetched block as one chunk
+    virtual void append(bcos::protocol::Block::Ptr _fetchedTxs);
+
+    // move at most _maxTxsSize transactions into the block in order, return the moved size
+    virtual size_t popTo(bcos::protocol::Block::Ptr _block, size_t _maxTxsSize);
+
+    // remove all the transactions, return the hashes of the removed transactions
+    virtual bcos::crypto::HashListPtr clear();
+
+    size_t size() const { return m_size; }
+
+private:
+    struct TxsChunk
+    {
+        bcos::protocol::Block::Ptr txs;
+        // the index of the first transaction not taken
+        size_t offset;
+    };
+    // swap in the input buffer when the output buffer is drained, require x_output
+    bool swapInput();
+
+    std::deque<TxsChunk> m_input;
+    Mutex x_input;
+    std::deque<TxsChunk> m_output;
+    Mutex x_output;
+
+    std::atomic<size_t> m_size = {0};
+};
+}  // namespace sealer
+}  // namespace bcos
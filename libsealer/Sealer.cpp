@@ -31,6 +31,8 @@ void Sealer::start()
         return;
     }
     SEAL_LOG(INFO) << LOG_DESC("start the sealer");
+    // the submit worker of the last run has been stopped
+    m_submitWorker = std::make_shared<ThreadPool>("sealerSubmit", 1);
     startWorking();
     m_running = true;
 }
@@ -52,6 +54,26 @@ void Sealer::stop()
         // will not restart worker, so terminate it
         terminate();
     }
+    // no proposal is generated after the sealing thread stopped, the proposals dropped by the
+    // submit worker are returned to the txpool
+    m_submitWorker->stop();
+    resetPendingProposals();
+}
+
+void Sealer::resetPendingProposals()
+{
+    std::deque<bcos::protocol::Block::Ptr> pendingProposals;
+    {
+        Guard l(x_pendingProposals);
+        pendingProposals.swap(m_pendingProposals);
+    }
+    for (auto const& proposal : pendingProposals)
+    {
+        SEAL_LOG(INFO) << LOG_DESC("resetPendingProposals: return back the unsubmitted proposal")
+                       << LOG_KV("index", proposal->blockHeader()->number())
+                       << LOG_KV("txsSize", proposal->transactionsHashSize());
+        m_sealingManager->notifyResetProposal(proposal);
+    }
 }
 
 void Sealer::init(bcos::consensus::ConsensusInterface::Ptr _consensus)
@@ -63,6 +85,7 @@ void Sealer::asyncNotifySealProposal(size_t _proposalStartIndex, size_t _proposa
     size_t _maxTxsPerBlock, std::function<void(Error::Ptr)> _onRecvResponse)
 {
     m_sealingManager->resetSealingInfo(_proposalStartIndex, _proposalEndIndex, _maxTxsPerBlock);
+    noteGenerateProposal();
     if (_onRecvResponse)
     {
         _onRecvResponse(nullptr);
@@ -76,6 +99,8 @@ void Sealer::asyncNotifySealProposal(size_t _proposalStartIndex, size_t _proposa
 void Sealer::asyncNoteLatestBlockNumber(int64_t _blockNumber)
 {
     m_sealingManager->resetCurrentNumber(_blockNumber);
+    // the sealing may wait for the block to be committed
+    noteGenerateProposal();
     SEAL_LOG(INFO) << LOG_DESC("asyncNoteLatestBlockNumber") << LOG_KV("number", _blockNumber);
 }
 
@@ -83,6 +108,7 @@ void Sealer::asyncNoteUnSealedTxsSize(
     size_t _unsealedTxsSize, std::function<void(Error::Ptr)> _onRecvResponse)
 {
     m_sealingManager->setUnsealedTxsSize(_unsealedTxsSize);
+    noteGenerateProposal();
     if (_onRecvResponse)
     {
         _onRecvResponse(nullptr);
@@ -93,9 +119,7 @@ void Sealer::executeWorker()
 {
     if (!m_sealingManager->shouldGenerateProposal() && !m_sealingManager->shouldFetchTransaction())
     {
-        ///< 10 milliseconds to next loop
-        boost::unique_lock<boost::mutex> l(x_signalled);
-        m_signalled.wait_for(l, boost::chrono::milliseconds(1));
+        waitSealingEvent();
     }
     // try to generateProposal
     if (m_sealingManager->shouldGenerateProposal())
@@ -111,7 +135,48 @@ void Sealer::executeWorker()
     }
 }
 
+void Sealer::waitSealingEvent()
+{
+    auto waitTime = std::min(m_sealingManager->sealingWaitTime(), (uint64_t)m_maxWaitTime);
+    boost::unique_lock<boost::mutex> l(x_signalled);
+    // the events noted after the check of the sealing conditions are not missed
+    m_signalled.wait_for(
+        l, boost::chrono::milliseconds(waitTime), [this]() { return m_sealingEvent; });
+    m_sealingEvent = false;
+}
+
 void Sealer::submitProposal(bool _containSysTxs, bcos::protocol::Block::Ptr _block)
+{
+    {
+        Guard l(x_pendingProposals);
+        m_pendingProposals.emplace_back(_block);
+    }
+    auto self = std::weak_ptr<Sealer>(shared_from_this());
+    m_submitWorker->enqueue([self, _containSysTxs, _block]() {
+        try
+        {
+            auto sealer = self.lock();
+            if (!sealer)
+            {
+                return;
+            }
+            {
+                // the proposals are submitted in order
+                Guard l(sealer->x_pendingProposals);
+                sealer->m_pendingProposals.pop_front();
+            }
+            sealer->encodeAndSubmitProposal(_containSysTxs, _block);
+        }
+        catch (std::exception const& e)
+        {
+            SEAL_LOG(WARNING) << LOG_DESC("submitProposal exception")
+                              << LOG_KV("index", _block->blockHeader()->number())
+                              << LOG_KV("error", boost::diagnostic_information(e));
+        }
+    });
+}
+
+void Sealer::encodeAndSubmitProposal(bool _containSysTxs, bcos::protocol::Block::Ptr _block)
 {
     if (_block->blockHeader()->number() <= m_sealingManager->currentNumber())
     {
@@ -22,6 +22,7 @@
 #include "../libutilities/Worker.h"
 #include "SealerConfig.h"
 #include "SealingManager.h"
+#include <deque>
 
 namespace bcos
 {
@@ -35,7 +36,7 @@ public:
       : Worker("Sealer", 0), m_sealerConfig(_sealerConfig)
     {
         m_sealingManager = std::make_shared<SealingManager>(_sealerConfig);
-        m_sealingManager->onReady([=]() { this->noteGenerateProposal(); });
+        m_onReadyHandler = m_sealingManager->onReady([=]() { this->noteGenerateProposal(); });
     }
     virtual ~Sealer() {}
 
@@ -55,18 +56,43 @@ public:
 
 protected:
     void executeWorker() override;
-    virtual void noteGenerateProposal() { m_signalled.notify_all(); }
+    // wake up the sealer when the state of sealing changed
+    virtual void noteGenerateProposal()
+    {
+        boost::unique_lock<boost::mutex> l(x_signalled);
+        m_sealingEvent = true;
+        m_signalled.notify_all();
+    }
+    // wait for the sealing event or the min seal time
+    virtual void waitSealingEvent();
 
+    // the proposal is encoded and submitted by m_submitWorker in order, the sealer continues to
+    // fetch transactions and generate the next proposal meanwhile
     virtual void submitProposal(bool _containSysTxs, bcos::protocol::Block::Ptr _proposal);
+    virtual void encodeAndSubmitProposal(
+        bool _containSysTxs, bcos::protocol::Block::Ptr _proposal);
+    // return the txs of the proposals not submitted back to the txpool
+    virtual void resetPendingProposals();
 
 protected:
     SealerConfig::Ptr m_sealerConfig;
     SealingManager::Ptr m_sealingManager;
+    // the callback is removed once the handler is released
+    bcos::Handler<> m_onReadyHandler;
     std::atomic_bool m_running = {false};
+    // created on start, the stopped thread pool can't be restarted
+    ThreadPool::Ptr m_submitWorker;
+
+    // the proposals enqueued to m_submitWorker and not submitted yet
+    std::deque<bcos::protocol::Block::Ptr> m_pendingProposals;
+    Mutex x_pendingProposals;
 
     boost::condition_variable m_signalled;
     // mutex to access m_signalled
     boost::mutex x_signalled;
+    bool m_sealingEvent = false;
+    // the max wait time without any event, to retry the failed fetching and check the stop
+    unsigned m_maxWaitTime = 100;
 };
 }  // namespace sealer
 }  // namespace bcos
\ No newline at end of file
@@ -44,6 +44,18 @@ public:
     virtual unsigned minSealTime() const { return m_minSealTime; }
     virtual void setMinSealTime(unsigned _minSealTime) { m_minSealTime = _minSealTime; }
 
+    // pick the block size and the min seal time by the observed load, within the bounds below and
+    // minSealTime/maxTxsPerBlock
+    virtual bool adaptiveSealing() const { return m_adaptiveSealing; }
+    virtual void setAdaptiveSealing(bool _adaptiveSealing) { m_adaptiveSealing = _adaptiveSealing; }
+    virtual unsigned minSealTimeLowerBound() const { return m_minSealTimeLowerBound; }
+    virtual void setMinSealTimeLowerBound(unsigned _minSealTimeLowerBound)
+    {
+        m_minSealTimeLowerBound = _minSealTimeLowerBound;
+    }
+    virtual size_t minTxsPerBlock() const { return m_minTxsPerBlock; }
+    virtual void setMinTxsPerBlock(size_t _minTxsPerBlock) { m_minTxsPerBlock = _minTxsPerBlock; }
+
     bcos::protocol::BlockFactory::Ptr blockFactory() { return m_blockFactory; }
     bcos::consensus::ConsensusInterface::Ptr consensus() { return m_consensus; }
 
@@ -52,6 +64,9 @@ protected:
     bcos::protocol::BlockFactory::Ptr m_blockFactory;
     bcos::consensus::ConsensusInterface::Ptr m_consensus;
     unsigned m_minSealTime = 500;
+    bool m_adaptiveSealing = false;
+    unsigned m_minSealTimeLowerBound = 50;
+    size_t m_minTxsPerBlock = 1;
 };
 }  // namespace sealer
 }  // namespace bcos
\ No newline at end of file
@@ -0,0 +1,153 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief adaptive controller of the block size and the min seal time
+ * @file SealingController.cpp
+ */
+#include "SealingController.h"
+using namespace bcos;
+using namespace bcos::sealer;
+
+// the weight of the newest sample
+static const double c_ewmaAlpha = 0.2;
+// the min interval to sample the arrival rate, the txpool may note on every transaction
+static const uint64_t c_arrivalSampleInterval = 100;
+// the max proposals tracked for the commit latency
+static const size_t c_maxTrackedProposals = 64;
+// the rounds the commit may lag behind the sealing before the block is shrunk
+static const double c_maxCommitLagRounds = 2;
+
+void SealingController::updateEWMA(double& _value, double _sample)
+{
+    _value = (_value == 0) ? _sample : (_value * (1 - c_ewmaAlpha) + _sample * c_ewmaAlpha);
+}
+
+void SealingController::onUnsealedTxsSize(size_t _unsealedTxsSize)
+{
+    auto now = utcSteadyTime();
+    Guard l(x_metrics);
+    if (m_lastNoteTime > 0)
+    {
+        auto elapsed = now - m_lastNoteTime;
+        if (elapsed < c_arrivalSampleInterval)
+        {
+            return;
+        }
+        // arrived = the increment of the unsealed txs + the fetched txs
+        auto arrivedTxs = (int64_t)_unsealedTxsSize - (int64_t)m_lastUnsealedTxsSize +
+                          (int64_t)m_fetchedTxsSize;
+        updateEWMA(m_metrics.arrivalRate, (double)std::max(arrivedTxs, (int64_t)0) / elapsed);
+    }
+    m_lastNoteTime = now;
+    m_lastUnsealedTxsSize = _unsealedTxsSize;
+    m_fetchedTxsSize = 0;
+}
+
+void SealingController::onTxsFetched(size_t _txsSize)
+{
+    Guard l(x_metrics);
+    m_fetchedTxsSize += _txsSize;
+}
+
+void SealingController::onProposalSealed(int64_t _number)
+{
+    auto now = utcSteadyTime();
+    Guard l(x_metrics);
+    m_sealTimes[_number] = now;
+    if (m_sealTimes.size() > c_maxTrackedProposals)
+    {
+        m_sealTimes.erase(m_sealTimes.begin());
+    }
+}
+
+void SealingController::onBlockCommitted(int64_t _number)
+{
+    auto now = utcSteadyTime();
+    Guard l(x_metrics);
+    if (_number <= m_lastCommitNumber)
+    {
+        return;
+    }
+    if (m_lastCommitTime > 0)
+    {
+        updateEWMA(
+            m_metrics.roundTime, (double)(now - m_lastCommitTime) / (_number - m_lastCommitNumber));
+    }
+    m_lastCommitTime = now;
+    m_lastCommitNumber = _number;
+    auto it = m_sealTimes.find(_number);
+    if (it != m_sealTimes.end())
+    {
+        updateEWMA(m_metrics.commitLatency, (double)(now - it->second));
+    }
+    m_sealTimes.erase(m_sealTimes.begin(), m_sealTimes.upper_bound(_number));
+}
+
+size_t SealingController::calculateTargetTxsPerBlock(size_t _maxTxsPerBlock) const
+{
+    if (!m_config->adaptiveSealing() || m_metrics.arrivalRate == 0 || m_metrics.roundTime == 0)
+    {
+        return _maxTxsPerBlock;
+    }
+    // the txs arriving in one consensus round
+    auto targetTxs = m_metrics.arrivalRate * m_metrics.roundTime;
+    // the execution can't keep up with the consensus if the commit lags too many rounds, shrink
+    // the block to let the commit catch up
+    auto maxCommitLatency = c_maxCommitLagRounds * m_metrics.roundTime;
+    if (m_metrics.commitLatency > maxCommitLatency)
+    {
+        targetTxs = targetTxs * maxCommitLatency / m_metrics.commitLatency;
+    }
+    auto targetTxsPerBlock = (size_t)targetTxs;
+    targetTxsPerBlock = std::max(targetTxsPerBlock, m_config->minTxsPerBlock());
+    return std::min(targetTxsPerBlock, _maxTxsPerBlock);
+}
+
+size_t SealingController::targetTxsPerBlock(size_t _maxTxsPerBlock)
+{
+    Guard l(x_metrics);
+    m_metrics.targetTxsPerBlock = calculateTargetTxsPerBlock(_maxTxsPerBlock);
+    return m_metrics.targetTxsPerBlock;
+}
+
+uint64_t SealingController::sealTime(size_t _pendingTxsSize, size_t _maxTxsPerBlock)
+{
+    uint64_t maxSealTime = m_config->minSealTime();
+    uint64_t minSealTime = std::min((uint64_t)m_config->minSealTimeLowerBound(), maxSealTime);
+    Guard l(x_metrics);
+    auto targetTxsPerBlock = calculateTargetTxsPerBlock(_maxTxsPerBlock);
+    // the fixed min seal time if the adaptive sealing is off
+    auto sealTime = maxSealTime;
+    auto adaptiveSealing = m_config->adaptiveSealing();
+    if (adaptiveSealing && _pendingTxsSize >= targetTxsPerBlock)
+    {
+        sealTime = minSealTime;
+    }
+    else if (adaptiveSealing && m_metrics.arrivalRate > 0)
+    {
+        // wait for the block to be filled
+        auto fillTime = (targetTxsPerBlock - _pendingTxsSize) / m_metrics.arrivalRate;
+        sealTime = std::max(minSealTime, std::min(maxSealTime, (uint64_t)fillTime));
+    }
+    m_metrics.targetTxsPerBlock = targetTxsPerBlock;
+    m_metrics.sealTime = sealTime;
+    return sealTime;
+}
+
+SealingController::Metrics SealingController::metrics() const
+{
+    Guard l(x_metrics);
+    return m_metrics;
+}
@@ -0,0 +1,86 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief adaptive controller of the block size and the min seal time
+ * @file SealingController.h
+ */
+#pragma once
+#include "SealerConfig.h"
+#include <map>
+
+namespace bcos
+{
+namespace sealer
+{
+/**
+ * @brief picks the size and the min seal time of the next block by the observed load
+ *        the arrival rate of the transactions, the commit latency of the sealed blocks and the
+ *        consensus round time are smoothed with EWMA, the next block is expected to hold the
+ *        transactions arriving in one round and is sealed once it's expected to be filled, the
+ *        block is shrunk when the commit latency lags too many rounds behind the sealing
+ *        the decisions are bounded by the sealer config and fixed if adaptiveSealing is off
+ */
+class SealingController
+{
+public:
+    using Ptr = std::shared_ptr<SealingController>;
+    // the observations and the latest decisions
+    struct Metrics
+    {
+        // the arrived transactions per millisecond
+        double arrivalRate = 0;
+        // the milliseconds from sealing a block to committing it
+        double commitLatency = 0;
+        // the milliseconds between two committed blocks
+        double roundTime = 0;
+        size_t targetTxsPerBlock = 0;
+        uint64_t sealTime = 0;
+    };
+
+    explicit SealingController(SealerConfig::Ptr _config) : m_config(_config) {}
+    virtual ~SealingController() {}
+
+    // the unsealed txs size noted by the txpool
+    virtual void onUnsealedTxsSize(size_t _unsealedTxsSize);
+    virtual void onTxsFetched(size_t _txsSize);
+    virtual void onProposalSealed(int64_t _number);
+    virtual void onBlockCommitted(int64_t _number);
+
+    // the proposal is generated once the pending txs reach the target
+    virtual size_t targetTxsPerBlock(size_t _maxTxsPerBlock);
+    // the proposal is generated once the min seal time passed since the last sealing
+    virtual uint64_t sealTime(size_t _pendingTxsSize, size_t _maxTxsPerBlock);
+
+    virtual Metrics metrics() const;
+
+private:
+    size_t calculateTargetTxsPerBlock(size_t _maxTxsPerBlock) const;
+    static void updateEWMA(double& _value, double _sample);
+
+    SealerConfig::Ptr m_config;
+    Metrics m_metrics;
+    mutable Mutex x_metrics;
+
+    uint64_t m_lastNoteTime = 0;
+    size_t m_lastUnsealedTxsSize = 0;
+    // the txs fetched since the last sampling of the arrival rate
+    size_t m_fetchedTxsSize = 0;
+    uint64_t m_lastCommitTime = 0;
+    int64_t m_lastCommitNumber = 0;
+    // the sealed time of the proposals not committed
+    std::map<int64_t, uint64_t> m_sealTimes;
+};
+}  // namespace sealer
+}  // namespace bcos
@@ -32,17 +32,11 @@ void SealingManager::resetSealing()
     clearPendingTxs();
 }
 
-void SealingManager::appendTransactions(
-    std::shared_ptr<TxsMetaDataQueue> _txsQueue, Block::Ptr _fetchedTxs)
+void SealingManager::appendTransactions(PendingTxsQueue::Ptr _txsQueue, Block::Ptr _fetchedTxs)
 {
-    WriteGuard l(x_pendingTxs);
-    // append the system transactions
-    for (size_t i = 0; i < _fetchedTxs->transactionsMetaDataSize(); i++)
-    {
-        _txsQueue->emplace_back(
-            std::const_pointer_cast<TransactionMetaData>(_fetchedTxs->transactionMetaData(i)));
-    }
-    m_onReady();
+    // the fetched transactions are appended as one chunk
+    m_sealingController->onTxsFetched(_fetchedTxs->transactionsMetaDataSize());
+    _txsQueue->append(_fetchedTxs);
 }
 
 bool SealingManager::shouldGenerateProposal()
@@ -59,7 +53,8 @@ bool SealingManager::shouldGenerateProposal()
     }
     // check the txs size
     auto txsSize = pendingTxsSize();
-    if (txsSize >= m_maxTxsPerBlock || reachMinSealTimeCondition())
+    if (txsSize >= m_sealingController->targetTxsPerBlock(m_maxTxsPerBlock) ||
+        reachMinSealTimeCondition())
     {
         return true;
     }
@@ -68,24 +63,20 @@ bool SealingManager::shouldGenerateProposal()
 
 void SealingManager::clearPendingTxs()
 {
-    UpgradableGuard l(x_pendingTxs);
-    auto pendingTxsSize = m_pendingTxs->size() + m_pendingSysTxs->size();
-    if (pendingTxsSize == 0)
+    if (pendingTxsSize() == 0)
     {
         return;
     }
-    // return the txs back to the txpool
-    SEAL_LOG(INFO) << LOG_DESC("clearPendingTxs: return back the unhandled transactions")
-                   << LOG_KV("size", pendingTxsSize);
-    HashListPtr unHandledTxs = std::make_shared<HashList>();
-    for (auto txMetaData : *m_pendingTxs)
-    {
-        unHandledTxs->emplace_back(txMetaData->hash());
-    }
-    for (auto txMetaData : *m_pendingSysTxs)
+    HashListPtr unHandledTxs = m_pendingTxs->clear();
+    auto unHandledSysTxs = m_pendingSysTxs->clear();
+    unHandledTxs->insert(unHandledTxs->end(), unHandledSysTxs->begin(), unHandledSysTxs->end());
+    if (unHandledTxs->empty())
     {
-        unHandledTxs->emplace_back(txMetaData->hash());
+        return;
     }
+    // return the txs back to the txpool
+    SEAL_LOG(INFO) << LOG_DESC("clearPendingTxs: return back the unhandled transactions")
+                   << LOG_KV("size", unHandledTxs->size());
     auto self = std::weak_ptr<SealingManager>(shared_from_this());
     m_worker->enqueue([self, unHandledTxs]() {
         try
@@ -104,9 +95,6 @@ void SealingManager::clearPendingTxs()
                 << LOG_KV("error", boost::diagnostic_information(e));
         }
     });
-    UpgradeGuard ul(l);
-    m_pendingTxs->clear();
-    m_pendingSysTxs->clear();
 }
 
 void SealingManager::notifyResetTxsFlag(HashListPtr _txsHashList, bool _flag, size_t _retryTime)
@@ -142,17 +130,14 @@ std::pair<bool, bcos::protocol::Block::Ptr> SealingManager::generateProposal()
     {
         return std::pair(false, nullptr);
     }
-    WriteGuard l(x_pendingTxs);
     m_sealingNumber = std::max(m_sealingNumber.load(), m_currentNumber.load() + 1);
     auto block = m_config->blockFactory()->createBlock();
     auto blockHeader = m_config->blockFactory()->blockHeaderFactory()->createBlockHeader();
     blockHeader->setNumber(m_sealingNumber);
     blockHeader->setTimestamp(utcTime());
     block->setBlockHeader(blockHeader);
-    auto txsSize =
-        std::min((size_t)m_maxTxsPerBlock, (m_pendingTxs->size() + m_pendingSysTxs->size()));
-    // prioritize seal from the system txs list
-    auto systemTxsSize = std::min(txsSize, m_pendingSysTxs->size());
+    // the size of the block is picked by the observed load
+    auto maxTxsPerBlock = m_sealingController->targetTxsPerBlock(m_maxTxsPerBlock);
     if (m_pendingSysTxs->size() > 0)
     {
         m_waitUntil.store(m_sealingNumber);
@@ -160,18 +145,19 @@ std::pair<bool, bcos::protocol::Block::Ptr> SealingManager::generateProposal()
                        << LOG_KV("sealNextBlockUntil", m_waitUntil)
                        << LOG_KV("curNum", m_currentNumber);
     }
-    bool containSysTxs = false;
-    for (size_t i = 0; i < systemTxsSize; i++)
-    {
-        block->appendTransactionMetaData(m_pendingSysTxs->front());
-        m_pendingSysTxs->pop_front();
-        containSysTxs = true;
-    }
-    for (size_t i = systemTxsSize; i < txsSize; i++)
-    {
-        block->appendTransactionMetaData(m_pendingTxs->front());
-        m_pendingTxs->pop_front();
-    }
+    // prioritize seal from the system txs list
+    auto systemTxsSize = m_pendingSysTxs->popTo(block, maxTxsPerBlock);
+    bool containSysTxs = (systemTxsSize > 0);
+    m_pendingTxs->popTo(block, maxTxsPerBlock - systemTxsSize);
+    m_sealingController->onProposalSealed(m_sealingNumber);
+    auto metrics = m_sealingController->metrics();
+    SEAL_LOG(DEBUG) << LOG_DESC("generateProposal") << LOG_KV("number", m_sealingNumber)
+                    << LOG_KV("txsSize", block->transactionsMetaDataSize())
+                    << LOG_KV("targetTxsSize", metrics.targetTxsPerBlock)
+                    << LOG_KV("sealTime", metrics.sealTime)
+                    << LOG_KV("arrivalRate", metrics.arrivalRate)
+                    << LOG_KV("commitLatency", metrics.commitLatency)
+                    << LOG_KV("roundTime", metrics.roundTime);
     m_sealingNumber++;
 
     m_lastSealTime = utcSteadyTime();
@@ -183,7 +169,6 @@ std::pair<bool, bcos::protocol::Block::Ptr> SealingManager::generateProposal()
 
 size_t SealingManager::pendingTxsSize()
 {
-    ReadGuard l(x_pendingTxs);
     return m_pendingSysTxs->size() + m_pendingTxs->size();
 }
 bool SealingManager::reachMinSealTimeCondition()
@@ -193,13 +178,30 @@ bool SealingManager::reachMinSealTimeCondition()
     {
         return false;
     }
-    if ((utcSteadyTime() - m_lastSealTime) < m_config->minSealTime())
+    if ((utcSteadyTime() - m_lastSealTime) <
+        m_sealingController->sealTime(txsSize, m_maxTxsPerBlock))
     {
         return false;
     }
     return true;
 }
 
+uint64_t SealingManager::sealingWaitTime()
+{
+    if (m_sealingNumber < m_startSealingNumber || m_sealingNumber > m_endSealingNumber ||
+        m_currentNumber < m_waitUntil || pendingTxsSize() == 0)
+    {
+        return std::numeric_limits<uint64_t>::max();
+    }
+    auto sealTime = m_sealingController->sealTime(pendingTxsSize(), m_maxTxsPerBlock);
+    auto sealingElapsed = utcSteadyTime() - m_lastSealTime;
+    if (sealingElapsed >= sealTime)
+    {
+        return 0;
+    }
+    return sealTime - sealingElapsed;
+}
+
 bool SealingManager::shouldFetchTransaction()
 {
     // fetching transactions currently
@@ -217,7 +219,8 @@ bool SealingManager::shouldFetchTransaction()
 
 int64_t SealingManager::txsSizeExpectedToFetch()
 {
-    auto txsSizeToFetch = (m_endSealingNumber - m_sealingNumber + 1) * m_maxTxsPerBlock;
+    auto txsSizeToFetch = (m_endSealingNumber - m_sealingNumber + 1) *
+                          m_sealingController->targetTxsPerBlock(m_maxTxsPerBlock);
     auto txsSize = pendingTxsSize();
     if (txsSizeToFetch <= txsSize)
     {
@@ -254,12 +257,16 @@ void SealingManager::fetchTransactions()
                     SEAL_LOG(WARNING) << LOG_DESC("fetchTransactions exception")
                                       << LOG_KV("returnCode", _error->errorCode())
                                       << LOG_KV("returnMsg", _error->errorMessage());
+                    // wake up the sealer to retry fetching
                     sealingMgr->m_fetchingTxs = false;
+                    sealingMgr->m_onReady();
                     return;
                 }
                 sealingMgr->appendTransactions(sealingMgr->m_pendingTxs, _txsHashList);
                 sealingMgr->appendTransactions(sealingMgr->m_pendingSysTxs, _sysTxsList);
+                // the woken sealer can fetch again, even if nothing is fetched
                 sealingMgr->m_fetchingTxs = false;
+                sealingMgr->m_onReady();
             }
             catch (std::exception const& e)
             {
@@ -23,12 +23,13 @@
 #include "../libutilities/CallbackCollectionHandler.h"
 #include "../libutilities/ThreadPool.h"
 #include "Common.h"
+#include "PendingTxsQueue.h"
 #include "SealerConfig.h"
+#include "SealingController.h"
 namespace bcos
 {
 namespace sealer
 {
-using TxsMetaDataQueue = std::deque<bcos::protocol::TransactionMetaData::Ptr>;
 class SealingManager : public std::enable_shared_from_this<SealingManager>
 {
 public:
@@ -36,8 +37,9 @@ public:
     using ConstPtr = std::shared_ptr<SealingManager const>;
     explicit SealingManager(SealerConfig::Ptr _config)
       : m_config(_config),
-        m_pendingTxs(std::make_shared<TxsMetaDataQueue>()),
-        m_pendingSysTxs(std::make_shared<TxsMetaDataQueue>()),
+        m_pendingTxs(std::make_shared<PendingTxsQueue>()),
+        m_pendingSysTxs(std::make_shared<PendingTxsQueue>()),
+        m_sealingController(std::make_shared<SealingController>(_config)),
         m_worker(std::make_shared<ThreadPool>("sealerWorker", 1))
     {}
 
@@ -53,11 +55,15 @@ public:
 
     virtual bool shouldGenerateProposal();
     virtual bool shouldFetchTransaction();
+    // the milliseconds before the min seal time is reached, UINT64_MAX if no proposal can be
+    // generated until the txs are fetched, the sealing info is reset or the block is committed
+    virtual uint64_t sealingWaitTime();
 
     std::pair<bool, bcos::protocol::Block::Ptr> generateProposal();
     virtual void setUnsealedTxsSize(size_t _unsealedTxsSize)
     {
         m_unsealedTxsSize = _unsealedTxsSize;
+        m_sealingController->onUnsealedTxsSize(_unsealedTxsSize);
         m_config->consensus()->asyncNoteUnSealedTxsSize(_unsealedTxsSize, [](Error::Ptr _error) {
             if (_error)
             {
@@ -93,7 +99,11 @@ public:
                        << LOG_KV("sealingNumber", m_sealingNumber);
     }
 
-    virtual void resetCurrentNumber(int64_t _currentNumber) { m_currentNumber = _currentNumber; }
+    virtual void resetCurrentNumber(int64_t _currentNumber)
+    {
+        m_currentNumber = _currentNumber;
+        m_sealingController->onBlockCommitted(_currentNumber);
+    }
     virtual int64_t currentNumber() const { return m_currentNumber; }
     virtual void fetchTransactions();
 
@@ -104,9 +114,11 @@ public:
     }
     virtual void notifyResetProposal(bcos::protocol::Block::Ptr _block);
 
+    SealingController::Ptr sealingController() const { return m_sealingController; }
+
 protected:
     virtual void appendTransactions(
-        std::shared_ptr<TxsMetaDataQueue> _txsQueue, bcos::protocol::Block::Ptr _fetchedTxs);
+        PendingTxsQueue::Ptr _txsQueue, bcos::protocol::Block::Ptr _fetchedTxs);
     virtual bool reachMinSealTimeCondition();
     virtual void clearPendingTxs();
     virtual void notifyResetTxsFlag(
@@ -117,9 +129,9 @@ protected:
 
 private:
     SealerConfig::Ptr m_config;
-    std::shared_ptr<TxsMetaDataQueue> m_pendingTxs;
-    std::shared_ptr<TxsMetaDataQueue> m_pendingSysTxs;
-    SharedMutex x_pendingTxs;
+    PendingTxsQueue::Ptr m_pendingTxs;
+    PendingTxsQueue::Ptr m_pendingSysTxs;
+    SealingController::Ptr m_sealingController;
 
     ThreadPool::Ptr m_worker;
 
@@ -18,19 +18,130 @@
  */
 
 #include "Base64.h"
-#include <boost/algorithm/string.hpp>
-#include <boost/archive/iterators/base64_from_binary.hpp>
-#include <boost/archive/iterators/binary_from_base64.hpp>
-#include <boost/archive/iterators/transform_width.hpp>
-#include <boost/iostreams/copy.hpp>
+#include "Exceptions.h"
+#include <cstring>
 
-using namespace boost::archive::iterators;
+using namespace bcos;
+
+namespace
+{
+char const c_base64Chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// the two base64 chars of every 12-bit value, so that 3 bytes are encoded with two lookups
+struct Base64EncodeTable
+{
+    constexpr Base64EncodeTable() : chars()
+    {
+        for (size_t i = 0; i < 4096; i++)
+        {
+            chars[i][0] = c_base64Chars[i >> 6];
+            chars[i][1] = c_base64Chars[i & 0x3f];
+        }
+    }
+    char chars[4096][2];
+};
+
+// the 6-bit value of every char, 0xff for the non-base64 chars
+struct Base64DecodeTable
+{
+    constexpr Base64DecodeTable() : values()
+    {
+        for (size_t i = 0; i < 256; i++)
+        {
+            values[i] = 0xff;
+        }
+        for (size_t i = 0; i < 64; i++)
+        {
+            values[(uint8_t)c_base64Chars[i]] = i;
+        }
+    }
+    uint8_t values[256];
+};
+
+constexpr Base64EncodeTable c_base64EncodeTable;
+constexpr Base64DecodeTable c_base64DecodeTable;
+}  // namespace
+
+void bcos::base64Encode(const byte* _begin, size_t _dataSize, char* _out)
+{
+    size_t i = 0;
+    for (; i + 3 <= _dataSize; i += 3)
+    {
+        uint32_t value = (_begin[i] << 16) | (_begin[i + 1] << 8) | _begin[i + 2];
+        memcpy(_out, c_base64EncodeTable.chars[value >> 12], 2);
+        memcpy(_out + 2, c_base64EncodeTable.chars[value & 0xfff], 2);
+        _out += 4;
+    }
+    auto remainSize = _dataSize - i;
+    if (remainSize == 0)
+    {
+        return;
+    }
+    uint32_t value = _begin[i] << 16;
+    if (remainSize == 2)
+    {
+        value |= _begin[i + 1] << 8;
+    }
+    memcpy(_out, c_base64EncodeTable.chars[value >> 12], 2);
+    _out[2] = (remainSize == 2 ? c_base64Chars[(value >> 6) & 0x3f] : '=');
+    _out[3] = '=';
+}
+
+bool bcos::base64Decode(const char* _data, size_t _size, byte* _out, size_t& _decodedSize) noexcept
+{
+    auto const* values = c_base64DecodeTable.values;
+    // the padding is only allowed at the end of the complete data
+    if (_size % 4 == 0)
+    {
+        for (size_t i = 0; i < 2 && _size > 0 && _data[_size - 1] == '='; i++)
+        {
+            _size--;
+        }
+    }
+    if (_size % 4 == 1)
+    {
+        return false;
+    }
+    auto const* begin = _out;
+    // the high bit of the values is set once a non-base64 char is found
+    uint8_t invalid = 0;
+    size_t i = 0;
+    for (; i + 4 <= _size; i += 4)
+    {
+        auto v0 = values[(uint8_t)_data[i]];
+        auto v1 = values[(uint8_t)_data[i + 1]];
+        auto v2 = values[(uint8_t)_data[i + 2]];
+        auto v3 = values[(uint8_t)_data[i + 3]];
+        invalid |= (v0 | v1 | v2 | v3);
+        uint32_t value = (v0 << 18) | (v1 << 12) | (v2 << 6) | v3;
+        _out[0] = (byte)(value >> 16);
+        _out[1] = (byte)(value >> 8);
+        _out[2] = (byte)value;
+        _out += 3;
+    }
+    auto remainSize = _size - i;
+    if (remainSize > 0)
+    {
+        auto v0 = values[(uint8_t)_data[i]];
+        auto v1 = values[(uint8_t)_data[i + 1]];
+        auto v2 = (remainSize == 3 ? values[(uint8_t)_data[i + 2]] : 0);
+        invalid |= (v0 | v1 | v2);
+        uint32_t value = (v0 << 18) | (v1 << 12) | (v2 << 6);
+        *_out++ = (byte)(value >> 16);
+        if (remainSize == 3)
+        {
+            *_out++ = (byte)(value >> 8);
+        }
+    }
+    _decodedSize = _out - begin;
+    return (invalid & 0x80) == 0;
+}
 
 std::string bcos::base64Encode(const byte* _begin, const size_t _dataSize)
 {
-    using It = base64_from_binary<transform_width<byte*, 6, 8>>;
-    auto tmp = std::string(It(_begin), It(_begin + _dataSize));
-    return tmp.append((3 - _dataSize % 3) % 3, '=');
+    std::string encodedData(base64EncodedSize(_dataSize), 0);
+    base64Encode(_begin, _dataSize, encodedData.data());
+    return encodedData;
 }
 
 std::string bcos::base64Encode(std::string const& _data)
@@ -45,26 +156,24 @@ std::string bcos::base64Encode(bytesConstRef _data)
 
 std::string bcos::base64Decode(std::string const& _data)
 {
-    size_t suffix = 0;
-    for (size_t i = _data.size() - 1; i >= _data.size() - 3; --i)
+    std::string decodedData(base64DecodedMaxSize(_data.size()), 0);
+    size_t decodedSize = 0;
+    if (!base64Decode(_data.data(), _data.size(), (byte*)decodedData.data(), decodedSize))
     {
-        if (_data[i] == '=')
-        {
-            ++suffix;
-        }
-        else
-        {
-            break;
-        }
+        BOOST_THROW_EXCEPTION(BadBase64Character());
     }
-    using It = transform_width<binary_from_base64<std::string::const_iterator>, 8, 6>;
-    auto ret = std::string(It(_data.begin()), It(std::end(_data)));
-    ret.resize(ret.size() - suffix);
-    return ret;
+    decodedData.resize(decodedSize);
+    return decodedData;
 }
 
 std::shared_ptr<bcos::bytes> bcos::base64DecodeBytes(std::string const& _data)
 {
-    auto s = base64Decode(_data);
-    return std::make_shared<bcos::bytes>(s.begin(), s.end());
+    auto decodedData = std::make_shared<bcos::bytes>(base64DecodedMaxSize(_data.size()));
+    size_t decodedSize = 0;
+    if (!base64Decode(_data.data(), _data.size(), decodedData->data(), decodedSize))
+    {
+        BOOST_THROW_EXCEPTION(BadBase64Character());
+    }
+    decodedData->resize(decodedSize);
+    return decodedData;
 }
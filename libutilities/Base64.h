@@ -21,11 +21,36 @@
 
 namespace bcos
 {
+// the size of the base64 encoded data, with the padding
+inline size_t base64EncodedSize(size_t _dataSize)
+{
+    return (_dataSize + 2) / 3 * 4;
+}
+// the upper bound of the size of the decoded data
+inline size_t base64DecodedMaxSize(size_t _size)
+{
+    return (_size + 3) / 4 * 3;
+}
+
+// encode into _out, which must hold at least base64EncodedSize(_dataSize) chars
+void base64Encode(const byte* _begin, size_t _dataSize, char* _out);
+/**
+ * @brief the validating decoder that never throws, the padding is optional
+ *
+ * @param _data : the base64 encoded data
+ * @param _size : the size of the encoded data
+ * @param _out : the output, must hold at least base64DecodedMaxSize(_size) bytes
+ * @param _decodedSize : the size of the decoded data
+ * @return false if the data is not valid base64
+ */
+bool base64Decode(const char* _data, size_t _size, byte* _out, size_t& _decodedSize) noexcept;
+
 std::string base64Encode(const byte* _begin, const size_t _dataSize);
 
 std::string base64Encode(std::string const& _data);
 std::string base64Encode(bytesConstRef _data);
 
+// throw BadBase64Character if the data is not valid base64
 std::shared_ptr<bytes> base64DecodeBytes(std::string const& _data);
 std::string base64Decode(std::string const& _data);
 }  // namespace bcos
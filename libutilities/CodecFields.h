@@ -0,0 +1,30 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief declares the encoded fields of a struct without depending on the codec
+ * @file CodecFields.h
+ */
+#pragma once
+#include <tuple>
+
+/**
+ * @brief declares the fields of a struct to be encoded in order, e.g.
+ *        struct Header { BlockNumber number; HashType hash; BCOS_SCALE_FIELDS(number, hash) };
+ *        must be placed in the public section of the struct, the scale streams encode and decode
+ *        the struct by the fields, see libcodec/scale/ScaleFields.h
+ */
+#define BCOS_SCALE_FIELDS(...)                                \
+    auto codecFields() { return std::tie(__VA_ARGS__); }      \
+    auto codecFields() const { return std::tie(__VA_ARGS__); }
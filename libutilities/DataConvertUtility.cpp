@@ -61,9 +61,9 @@ std::shared_ptr<bytes> bcos::fromHexString(std::string const& _hexedString)
 {
     unsigned startIndex =
         (_hexedString.size() >= 2 && _hexedString[0] == '0' && _hexedString[1] == 'x') ? 2 : 0;
-    std::shared_ptr<bytes> bytesData = std::make_shared<bytes>();
-    bytesData->reserve((_hexedString.size() - startIndex + 1) / 2);
-
+    std::shared_ptr<bytes> bytesData =
+        std::make_shared<bytes>((_hexedString.size() - startIndex + 1) / 2);
+    size_t offset = 0;
     if (_hexedString.size() % 2)
     {
         int h = convertCharToHexNumber(_hexedString[startIndex++]);
@@ -71,17 +71,12 @@ std::shared_ptr<bytes> bcos::fromHexString(std::string const& _hexedString)
         {
             BOOST_THROW_EXCEPTION(BadHexCharacter());
         }
-        bytesData->push_back(h);
+        (*bytesData)[offset++] = h;
     }
-    for (unsigned i = startIndex; i < _hexedString.size(); i += 2)
+    if (!decodeHex(_hexedString.data() + startIndex, _hexedString.size() - startIndex,
+            bytesData->data() + offset))
     {
-        int highValue = convertCharToHexNumber(_hexedString[i]);
-        int lowValue = convertCharToHexNumber(_hexedString[i + 1]);
-        if (highValue == -1 || lowValue == -1)
-        {
-            BOOST_THROW_EXCEPTION(BadHexCharacter());
-        }
-        bytesData->push_back((bcos::byte)(highValue << 4) + lowValue);
+        BOOST_THROW_EXCEPTION(BadHexCharacter());
     }
     return bytesData;
 }
@@ -20,7 +20,9 @@
 
 #include "Common.h"
 #include "Error.h"
+#include "HexCodec.h"
 #include <boost/algorithm/hex.hpp>
+#include <boost/endian/conversion.hpp>
 #include <boost/throw_exception.hpp>
 #include <algorithm>
 #include <cstring>
@@ -35,21 +37,10 @@ namespace bcos
 template <class Binary, class Out = std::string>
 Out toHex(const Binary& binary, const std::string_view& prefix = std::string_view())
 {
-    Out out;
-
-    out.reserve(binary.size() * 2 + prefix.size());
-
-    if (!prefix.empty())
-    {
-        out.insert(out.end(), prefix.begin(), prefix.end());
-    }
-
-    if (binary.empty())
-    {
-        return out;
-    }
-
-    boost::algorithm::hex_lower(binary.begin(), binary.end(), std::back_inserter(out));
+    static_assert(sizeof(*binary.data()) == 1, "only support byte-sized element type");
+    Out out(binary.size() * 2 + prefix.size(), 0);
+    std::copy(prefix.begin(), prefix.end(), out.begin());
+    encodeHex((byte const*)binary.data(), binary.size(), (char*)out.data() + prefix.size());
     return out;
 }
 
@@ -61,15 +52,17 @@ Out fromHex(const Hex& hex, const std::string_view& prefix = std::string_view())
         BOOST_THROW_EXCEPTION(BCOS_ERROR(-1, "Empty input hex string"));
     }
 
-    if ((hex.size() < prefix.size() + 2) || (hex.size() % 2 != 0))
+    if ((hex.size() < prefix.size() + 2) || ((hex.size() - prefix.size()) % 2 != 0))
     {
         BOOST_THROW_EXCEPTION(BCOS_ERROR(-1, "Invalid input hex string size"));
     }
 
-    Out out;
-    out.reserve(hex.size() / 2);
-
-    boost::algorithm::unhex(hex.begin() + prefix.size(), hex.end(), std::back_inserter(out));
+    Out out((hex.size() - prefix.size()) / 2, 0);
+    if (!decodeHex((char const*)hex.data() + prefix.size(), hex.size() - prefix.size(),
+            (byte*)out.data()))
+    {
+        BOOST_THROW_EXCEPTION(BCOS_ERROR(-1, "Invalid input hex string"));
+    }
     return out;
 }
 
@@ -92,9 +85,15 @@ std::shared_ptr<std::string> toHexString(
     std::shared_ptr<std::string> hexString = std::make_shared<std::string>(hexStringSize, '0');
     // set the _prefix
     memcpy((void*)hexString->data(), (const void*)_prefix.data(), _prefix.size());
+    size_t offset = _prefix.size();
+    // the contiguous data is converted by the vectorized kernel
+    if constexpr (std::is_pointer<Iterator>::value)
+    {
+        encodeHex((byte const*)_begin, std::distance(_begin, _end), hexString->data() + offset);
+        return hexString;
+    }
     static char const* hexCharsCollection = "0123456789abcdef";
     // covert the bytes into hex chars
-    size_t offset = _prefix.size();
     for (auto it = _begin; it != _end; it++)
     {
         (*hexString)[offset++] = hexCharsCollection[(*it >> 4) & 0x0f];
@@ -103,6 +102,18 @@ std::shared_ptr<std::string> toHexString(
     return hexString;
 }
 
+// the data that exposes data() and size(), converted by the vectorized kernel
+template <class T, class = void>
+struct HasContiguousData : std::false_type
+{
+};
+template <class T>
+struct HasContiguousData<T, std::void_t<decltype(std::declval<T const&>().data()),
+                                decltype(std::declval<T const&>().size())>>
+  : std::is_pointer<decltype(std::declval<T const&>().data())>
+{
+};
+
 /**
  * @brief : convert the given data to hex string(without prefix)
  *
@@ -113,7 +124,14 @@ std::shared_ptr<std::string> toHexString(
 template <class T>
 std::shared_ptr<std::string> toHexString(T const& _data)
 {
-    return toHexString(_data.begin(), _data.end());
+    if constexpr (HasContiguousData<T>::value)
+    {
+        return toHexString(_data.data(), _data.data() + _data.size());
+    }
+    else
+    {
+        return toHexString(_data.begin(), _data.end());
+    }
 }
 
 /**
@@ -126,7 +144,14 @@ std::shared_ptr<std::string> toHexString(T const& _data)
 template <class T>
 std::string toHexStringWithPrefix(T const& _data)
 {
-    return *toHexString(_data.begin(), _data.end(), "0x");
+    if constexpr (HasContiguousData<T>::value)
+    {
+        return *toHexString(_data.data(), _data.data() + _data.size(), "0x");
+    }
+    else
+    {
+        return *toHexString(_data.begin(), _data.end(), "0x");
+    }
 }
 
 /**
@@ -211,6 +236,20 @@ inline bytes toBigEndian(u160 _val)
     return ret;
 }
 
+/// Converts the u256 to the 32 big-endian bytes at @a _out without the byte-by-byte shifting,
+/// the limbs (least significant first) of the value are copied directly.
+inline void toBigEndian32(u256 const& _val, byte* _out)
+{
+    auto const& backend = _val.backend();
+    using Limb = std::remove_const_t<std::remove_pointer_t<decltype(backend.limbs())>>;
+    memset(_out, 0, 32);
+    for (size_t i = 0; i < backend.size(); i++)
+    {
+        auto limb = boost::endian::native_to_big(backend.limbs()[i]);
+        memcpy(_out + 32 - (i + 1) * sizeof(Limb), &limb, sizeof(Limb));
+    }
+}
+
 /// Convenience function for toBigEndian.
 /// @returns a byte array just big enough to represent @a _val.
 template <class T>
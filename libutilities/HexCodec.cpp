@@ -0,0 +1,248 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief hex encode/decode kernels, vectorized with SSSE3/AVX2 and selected at runtime
+ * @file HexCodec.cpp
+ */
+#include "HexCodec.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define BCOS_HEX_SIMD 1
+#include <immintrin.h>
+#endif
+
+using namespace bcos;
+
+namespace
+{
+// the two hex chars of every byte value, built at compile time so that the kernels can be used
+// during static initialization
+struct HexEncodeTable
+{
+    constexpr HexEncodeTable() : chars()
+    {
+        char const hexChars[] = "0123456789abcdef";
+        for (size_t i = 0; i < 256; i++)
+        {
+            chars[i][0] = hexChars[i >> 4];
+            chars[i][1] = hexChars[i & 0x0f];
+        }
+    }
+    char chars[256][2];
+};
+
+// the nibble of every char, -1 for the non-hex chars
+struct HexDecodeTable
+{
+    constexpr HexDecodeTable() : nibbles()
+    {
+        for (size_t i = 0; i < 256; i++)
+        {
+            nibbles[i] = -1;
+        }
+        for (int i = 0; i < 10; i++)
+        {
+            nibbles['0' + i] = i;
+        }
+        for (int i = 0; i < 6; i++)
+        {
+            nibbles['a' + i] = 10 + i;
+            nibbles['A' + i] = 10 + i;
+        }
+    }
+    int8_t nibbles[256];
+};
+
+constexpr HexEncodeTable c_hexEncodeTable;
+constexpr HexDecodeTable c_hexDecodeTable;
+
+#ifdef BCOS_HEX_SIMD
+__attribute__((target("ssse3"))) void encodeHexSSSE3(byte const* _data, size_t _size, char* _hex)
+{
+    auto const table = _mm_setr_epi8(
+        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+    auto const mask = _mm_set1_epi8(0x0f);
+    size_t i = 0;
+    for (; i + 16 <= _size; i += 16)
+    {
+        auto value = _mm_loadu_si128((__m128i const*)(_data + i));
+        auto high = _mm_shuffle_epi8(table, _mm_and_si128(_mm_srli_epi16(value, 4), mask));
+        auto low = _mm_shuffle_epi8(table, _mm_and_si128(value, mask));
+        _mm_storeu_si128((__m128i*)(_hex + 2 * i), _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128((__m128i*)(_hex + 2 * i + 16), _mm_unpackhi_epi8(high, low));
+    }
+    encodeHexScalar(_data + i, _size - i, _hex + 2 * i);
+}
+
+// convert 16 hex chars into nibbles, _valid is cleared for the non-hex chars
+__attribute__((target("ssse3"))) inline __m128i hexNibblesSSSE3(__m128i _chars, __m128i& _valid)
+{
+    auto digits = _mm_sub_epi8(_chars, _mm_set1_epi8('0'));
+    auto letters = _mm_sub_epi8(_mm_or_si128(_chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    auto isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits);
+    auto isLetter = _mm_cmpeq_epi8(_mm_min_epu8(letters, _mm_set1_epi8(5)), letters);
+    _valid = _mm_and_si128(_valid, _mm_or_si128(isDigit, isLetter));
+    return _mm_or_si128(_mm_and_si128(isDigit, digits),
+        _mm_and_si128(isLetter, _mm_add_epi8(letters, _mm_set1_epi8(10))));
+}
+
+__attribute__((target("ssse3"))) bool decodeHexSSSE3(char const* _hex, size_t _size, byte* _data)
+{
+    // high nibble * 16 + low nibble
+    auto const weights = _mm_set1_epi16(0x0110);
+    auto valid = _mm_set1_epi8(-1);
+    size_t i = 0;
+    for (; i + 32 <= _size; i += 32)
+    {
+        auto first = hexNibblesSSSE3(_mm_loadu_si128((__m128i const*)(_hex + i)), valid);
+        auto second = hexNibblesSSSE3(_mm_loadu_si128((__m128i const*)(_hex + i + 16)), valid);
+        auto value =
+            _mm_packus_epi16(_mm_maddubs_epi16(first, weights), _mm_maddubs_epi16(second, weights));
+        _mm_storeu_si128((__m128i*)(_data + i / 2), value);
+    }
+    if (_mm_movemask_epi8(valid) != 0xffff)
+    {
+        return false;
+    }
+    return decodeHexScalar(_hex + i, _size - i, _data + i / 2);
+}
+
+__attribute__((target("avx2"))) void encodeHexAVX2(byte const* _data, size_t _size, char* _hex)
+{
+    auto const table = _mm256_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a',
+        'b', 'c', 'd', 'e', 'f', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c',
+        'd', 'e', 'f');
+    auto const mask = _mm256_set1_epi8(0x0f);
+    size_t i = 0;
+    for (; i + 32 <= _size; i += 32)
+    {
+        auto value = _mm256_loadu_si256((__m256i const*)(_data + i));
+        auto high =
+            _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(value, 4), mask));
+        auto low = _mm256_shuffle_epi8(table, _mm256_and_si256(value, mask));
+        // the unpack works inside the 128-bit lanes, regroup the lanes in order
+        auto first = _mm256_unpacklo_epi8(high, low);
+        auto second = _mm256_unpackhi_epi8(high, low);
+        _mm256_storeu_si256(
+            (__m256i*)(_hex + 2 * i), _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256(
+            (__m256i*)(_hex + 2 * i + 32), _mm256_permute2x128_si256(first, second, 0x31));
+    }
+    encodeHexSSSE3(_data + i, _size - i, _hex + 2 * i);
+}
+
+__attribute__((target("avx2"))) inline __m256i hexNibblesAVX2(__m256i _chars, __m256i& _valid)
+{
+    auto digits = _mm256_sub_epi8(_chars, _mm256_set1_epi8('0'));
+    auto letters =
+        _mm256_sub_epi8(_mm256_or_si256(_chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    auto isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(digits, _mm256_set1_epi8(9)), digits);
+    auto isLetter = _mm256_cmpeq_epi8(_mm256_min_epu8(letters, _mm256_set1_epi8(5)), letters);
+    _valid = _mm256_and_si256(_valid, _mm256_or_si256(isDigit, isLetter));
+    return _mm256_or_si256(_mm256_and_si256(isDigit, digits),
+        _mm256_and_si256(isLetter, _mm256_add_epi8(letters, _mm256_set1_epi8(10))));
+}
+
+__attribute__((target("avx2"))) bool decodeHexAVX2(char const* _hex, size_t _size, byte* _data)
+{
+    auto const weights = _mm256_set1_epi16(0x0110);
+    auto valid = _mm256_set1_epi8(-1);
+    size_t i = 0;
+    for (; i + 64 <= _size; i += 64)
+    {
+        auto first = hexNibblesAVX2(_mm256_loadu_si256((__m256i const*)(_hex + i)), valid);
+        auto second = hexNibblesAVX2(_mm256_loadu_si256((__m256i const*)(_hex + i + 32)), valid);
+        auto value = _mm256_packus_epi16(
+            _mm256_maddubs_epi16(first, weights), _mm256_maddubs_epi16(second, weights));
+        // the pack works inside the 128-bit lanes, regroup the 64-bit blocks in order
+        _mm256_storeu_si256((__m256i*)(_data + i / 2), _mm256_permute4x64_epi64(value, 0xd8));
+    }
+    if (_mm256_movemask_epi8(valid) != -1)
+    {
+        return false;
+    }
+    return decodeHexSSSE3(_hex + i, _size - i, _data + i / 2);
+}
+#endif
+
+struct HexKernels
+{
+    void (*encode)(byte const*, size_t, char*);
+    bool (*decode)(char const*, size_t, byte*);
+    char const* name;
+};
+
+HexKernels selectHexKernels()
+{
+#ifdef BCOS_HEX_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return {encodeHexAVX2, decodeHexAVX2, "avx2"};
+    }
+    if (__builtin_cpu_supports("ssse3"))
+    {
+        return {encodeHexSSSE3, decodeHexSSSE3, "ssse3"};
+    }
+#endif
+    return {encodeHexScalar, decodeHexScalar, "scalar"};
+}
+
+HexKernels const& hexKernels()
+{
+    static HexKernels const kernels = selectHexKernels();
+    return kernels;
+}
+}  // namespace
+
+void bcos::encodeHexScalar(byte const* _data, size_t _size, char* _hex)
+{
+    for (size_t i = 0; i < _size; i++)
+    {
+        auto const* chars = c_hexEncodeTable.chars[_data[i]];
+        _hex[2 * i] = chars[0];
+        _hex[2 * i + 1] = chars[1];
+    }
+}
+
+bool bcos::decodeHexScalar(char const* _hex, size_t _size, byte* _data)
+{
+    for (size_t i = 0; i + 1 < _size; i += 2)
+    {
+        int high = c_hexDecodeTable.nibbles[(uint8_t)_hex[i]];
+        int low = c_hexDecodeTable.nibbles[(uint8_t)_hex[i + 1]];
+        if ((high | low) < 0)
+        {
+            return false;
+        }
+        _data[i / 2] = (byte)((high << 4) | low);
+    }
+    return true;
+}
+
+void bcos::encodeHex(byte const* _data, size_t _size, char* _hex)
+{
+    hexKernels().encode(_data, _size, _hex);
+}
+
+bool bcos::decodeHex(char const* _hex, size_t _size, byte* _data)
+{
+    return hexKernels().decode(_hex, _size, _data);
+}
+
+char const* bcos::hexCodecKernel()
+{
+    return hexKernels().name;
+}
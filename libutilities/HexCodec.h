@@ -0,0 +1,49 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief hex encode/decode kernels, vectorized with SSSE3/AVX2 and selected at runtime
+ * @file HexCodec.h
+ */
+#pragma once
+#include "Common.h"
+
+namespace bcos
+{
+/**
+ * @brief encode the given bytes into lower case hex chars
+ *
+ * @param _data : the bytes to be encoded
+ * @param _size : the size of the bytes
+ * @param _hex : the output, must hold at least 2 * _size chars
+ */
+void encodeHex(byte const* _data, size_t _size, char* _hex);
+
+/**
+ * @brief decode the given hex chars (both upper and lower case) into bytes
+ *
+ * @param _hex : the hex chars to be decoded, without prefix
+ * @param _size : the number of the hex chars, must be even
+ * @param _data : the output, must hold at least _size / 2 bytes
+ * @return false if any non-hex char is found, the output is undefined in this case
+ */
+bool decodeHex(char const* _hex, size_t _size, byte* _data);
+
+// the byte-at-a-time kernels, used when no SIMD instruction set is available
+void encodeHexScalar(byte const* _data, size_t _size, char* _hex);
+bool decodeHexScalar(char const* _hex, size_t _size, byte* _data);
+
+// the name of the kernel selected at runtime: avx2, ssse3 or scalar
+char const* hexCodecKernel();
+}  // namespace bcos
@@ -0,0 +1,220 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @brief: bounded pool that recycles the released objects through a lock-free freelist
+ *  @file ObjectPool.h
+ */
+#pragma once
+#include <boost/lockfree/stack.hpp>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <new>
+
+namespace bcos
+{
+/**
+ * @brief the objects are handed out as shared_ptr, when the last reference is released, the
+ * object is reset and pushed back to the freelist instead of being deleted
+ *
+ * The control blocks of the handed out shared_ptrs are recycled through another freelist, so
+ * acquiring a pooled object allocates nothing. Both freelists are bounded by the capacity, the
+ * objects and the control blocks released when the freelist is full are deleted.
+ * Note: the state of the pool is retained after the pool is destroyed, so the objects still in
+ * use can be released without referencing the pool, the freelists are drained on destruction
+ */
+template <typename T>
+class ObjectPool
+{
+public:
+    using Ptr = std::shared_ptr<ObjectPool<T>>;
+    using CreateFunc = std::function<T*()>;
+    using ResetFunc = std::function<void(T&)>;
+
+    ObjectPool(size_t _capacity, CreateFunc _create, ResetFunc _reset)
+      : m_state(new State(_capacity, std::move(_create), std::move(_reset)))
+    {}
+    virtual ~ObjectPool() { m_state->close(); }
+
+    std::shared_ptr<T> acquire()
+    {
+        return std::shared_ptr<T>(
+            m_state->pop(), Releaser{m_state}, ControlBlockAllocator<T>(m_state));
+    }
+
+    // the number of the objects created by the pool
+    uint64_t allocatedCount() const { return m_state->allocatedCount; }
+    // the number of the objects handed out from the freelist
+    uint64_t reusedCount() const { return m_state->reusedCount; }
+    // the number of the control blocks allocated from the heap
+    uint64_t controlBlockAllocatedCount() const { return m_state->controlBlockAllocatedCount; }
+
+private:
+    struct State
+    {
+        State(size_t _capacity, CreateFunc _create, ResetFunc _reset)
+          : freeObjects(_capacity),
+            freeControlBlocks(_capacity),
+            create(std::move(_create)),
+            reset(std::move(_reset))
+        {}
+
+        T* pop()
+        {
+            T* object = nullptr;
+            if (freeObjects.pop(object))
+            {
+                reusedCount.fetch_add(1, std::memory_order_relaxed);
+                return object;
+            }
+            object = create();
+            allocatedCount.fetch_add(1, std::memory_order_relaxed);
+            return object;
+        }
+
+        void release(T* _object)
+        {
+            if (closed)
+            {
+                delete _object;
+                return;
+            }
+            try
+            {
+                reset(*_object);
+            }
+            catch (...)
+            {
+                delete _object;
+                return;
+            }
+            // the freelist is full
+            if (!freeObjects.bounded_push(_object))
+            {
+                delete _object;
+                return;
+            }
+            // the pool is destroyed during the release
+            if (closed)
+            {
+                drain();
+            }
+        }
+
+        void* allocateControlBlock(size_t _size)
+        {
+            // all the control blocks of the pool have the same size
+            size_t expectedSize = 0;
+            if (controlBlockSize.compare_exchange_strong(expectedSize, _size) ||
+                expectedSize == _size)
+            {
+                void* block = nullptr;
+                if (freeControlBlocks.pop(block))
+                {
+                    return block;
+                }
+            }
+            controlBlockAllocatedCount.fetch_add(1, std::memory_order_relaxed);
+            return ::operator new(_size);
+        }
+
+        void deallocateControlBlock(void* _block, size_t _size)
+        {
+            if (closed || _size != controlBlockSize || !freeControlBlocks.bounded_push(_block))
+            {
+                ::operator delete(_block);
+                return;
+            }
+            if (closed)
+            {
+                drain();
+            }
+        }
+
+        // no object is acquired after the pool is destroyed, release the resources held by create
+        void close()
+        {
+            closed = true;
+            create = nullptr;
+            drain();
+        }
+
+        // delete the objects and the control blocks in the freelists
+        void drain()
+        {
+            T* object = nullptr;
+            while (freeObjects.pop(object))
+            {
+                delete object;
+            }
+            void* block = nullptr;
+            while (freeControlBlocks.pop(block))
+            {
+                ::operator delete(block);
+            }
+        }
+
+        boost::lockfree::stack<T*> freeObjects;
+        boost::lockfree::stack<void*> freeControlBlocks;
+        CreateFunc create;
+        ResetFunc reset;
+        std::atomic_bool closed = {false};
+        std::atomic<size_t> controlBlockSize = {0};
+        std::atomic<uint64_t> allocatedCount = {0};
+        std::atomic<uint64_t> reusedCount = {0};
+        std::atomic<uint64_t> controlBlockAllocatedCount = {0};
+    };
+
+    // releases the object into the retained state, without referencing the pool
+    struct Releaser
+    {
+        void operator()(T* _object) const { state->release(_object); }
+        State* state;
+    };
+
+    // allocates the control blocks of the shared_ptrs from the freelist
+    template <typename U>
+    struct ControlBlockAllocator
+    {
+        using value_type = U;
+        explicit ControlBlockAllocator(State* _state) : state(_state) {}
+        template <typename V>
+        ControlBlockAllocator(ControlBlockAllocator<V> const& _allocator) : state(_allocator.state)
+        {}
+
+        U* allocate(size_t _n) { return (U*)state->allocateControlBlock(sizeof(U) * _n); }
+        void deallocate(U* _block, size_t _n)
+        {
+            state->deallocateControlBlock(_block, sizeof(U) * _n);
+        }
+
+        template <typename V>
+        bool operator==(ControlBlockAllocator<V> const& _allocator) const
+        {
+            return state == _allocator.state;
+        }
+        template <typename V>
+        bool operator!=(ControlBlockAllocator<V> const& _allocator) const
+        {
+            return state != _allocator.state;
+        }
+
+        State* state;
+    };
+
+    // not owned, retained for the objects released after the pool is destroyed
+    State* m_state;
+};
+}  // namespace bcos
\ No newline at end of file
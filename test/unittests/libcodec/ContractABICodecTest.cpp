@@ -22,6 +22,8 @@
 #include "testutils/TestPromptFixture.h"
 #include "testutils/crypto/HashImpl.h"
 #include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <thread>
 
 using namespace std;
 using namespace bcos;
@@ -869,6 +871,237 @@ BOOST_AUTO_TEST_CASE(testABITuple)
     }
 }
 
+BOOST_AUTO_TEST_CASE(testABIEncodeInPlace)
+{
+    auto hashImpl = std::make_shared<Keccak256Hash>();
+    ContractABICodec abi(hashImpl);
+    std::string sig = "set(uint256,string,uint256[2],bytes[],(string,uint256[2]))";
+    u256 a("0x123");
+    std::string b = "Hello, world!";
+    std::array<u256, 2> c = {u256(1), u256(2)};
+    std::vector<bytes> d = {bytes(33, 0xab), bytes()};
+    std::tuple<std::string, std::array<u256, 2>> e = {"tuple", {u256(3), u256(4)}};
+
+    // the selector is followed by the encoded params
+    auto encodedParams = abi.abiIn("", a, b, c, d, e);
+    auto encodedCall = abi.abiIn(sig, a, b, c, d, e);
+    BOOST_CHECK_EQUAL(encodedCall.size(), 4 + encodedParams.size());
+    auto selector = hashImpl->hash(sig).ref().getCroppedData(0, 4).toBytes();
+    BOOST_CHECK(bytes(encodedCall.begin(), encodedCall.begin() + 4) == selector);
+    BOOST_CHECK(bytes(encodedCall.begin() + 4, encodedCall.end()) == encodedParams);
+
+    // the static array is encoded in the head, the dynamic params are encoded in the tail
+    auto expectedParams = *fromHexString(
+        "0000000000000000000000000000000000000000000000000000000000000123"
+        "00000000000000000000000000000000000000000000000000000000000000c0"
+        "0000000000000000000000000000000000000000000000000000000000000001"
+        "0000000000000000000000000000000000000000000000000000000000000002"
+        "0000000000000000000000000000000000000000000000000000000000000100"
+        "00000000000000000000000000000000000000000000000000000000000001e0"
+        "000000000000000000000000000000000000000000000000000000000000000d"
+        "48656c6c6f2c20776f726c642100000000000000000000000000000000000000"
+        "0000000000000000000000000000000000000000000000000000000000000002"
+        "0000000000000000000000000000000000000000000000000000000000000040"
+        "00000000000000000000000000000000000000000000000000000000000000a0"
+        "0000000000000000000000000000000000000000000000000000000000000021"
+        "abababababababababababababababababababababababababababababababab"
+        "ab00000000000000000000000000000000000000000000000000000000000000"
+        "0000000000000000000000000000000000000000000000000000000000000000"
+        "0000000000000000000000000000000000000000000000000000000000000060"
+        "0000000000000000000000000000000000000000000000000000000000000003"
+        "0000000000000000000000000000000000000000000000000000000000000004"
+        "0000000000000000000000000000000000000000000000000000000000000005"
+        "7475706c65000000000000000000000000000000000000000000000000000000");
+    BOOST_CHECK_EQUAL(*toHexString(encodedParams), *toHexString(expectedParams));
+
+    u256 outA;
+    std::string outB;
+    std::array<u256, 2> outC;
+    std::vector<bytes> outD;
+    std::tuple<std::string, std::array<u256, 2>> outE;
+    BOOST_CHECK(abi.abiOut(bytesConstRef(&encodedParams), outA, outB, outC, outD, outE));
+    BOOST_CHECK(outA == a);
+    BOOST_CHECK_EQUAL(outB, b);
+    BOOST_CHECK(outC == c);
+    BOOST_CHECK(outD == d);
+    BOOST_CHECK(outE == e);
+
+    // the size is computed without encoding
+    BOOST_CHECK_EQUAL(ContractABICodec::encodedSize(b), abi.serialise(b).size());
+    BOOST_CHECK_EQUAL(ContractABICodec::encodedSize(c), abi.serialise(c).size());
+    BOOST_CHECK_EQUAL(ContractABICodec::encodedSize(d), abi.serialise(d).size());
+    BOOST_CHECK_EQUAL(ContractABICodec::encodedSize(e), abi.serialise(e).size());
+
+    // the small unsigned integers are encoded as one word
+    BOOST_CHECK_EQUAL(*toHexString(abi.abiIn("", (uint8_t)0xab, (uint32_t)0x12345678)),
+        std::string(62, '0') + "ab" + std::string(56, '0') + "12345678");
+    BOOST_CHECK_EQUAL(*toHexString(abi.serialise(-1)), std::string(64, 'f'));
+}
+
+BOOST_AUTO_TEST_CASE(testABIFuncCache)
+{
+    auto hashImpl = std::make_shared<Keccak256Hash>();
+    auto cache = std::make_shared<ABIFuncCache>(hashImpl);
+    ContractABICodec abi(hashImpl);
+
+    // the signature is parsed once and shared by all the threads
+    std::string sig = "transfer(string,address,uint256,int256)";
+    std::vector<ABIFunc::ConstPtr> funcs(8);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < funcs.size(); i++)
+    {
+        threads.emplace_back([&, i]() { funcs[i] = cache->getFunc(sig); });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    BOOST_CHECK(funcs[0] != nullptr);
+    for (auto const& func : funcs)
+    {
+        BOOST_CHECK(func == funcs[0]);
+    }
+    BOOST_CHECK(cache->getFunc(sig) == funcs[0]);
+    BOOST_CHECK_EQUAL(cache->size(), 1);
+    BOOST_CHECK(cache->getFunc("transfer(string,uint25)") == nullptr);
+    BOOST_CHECK_EQUAL(cache->size(), 1);
+
+    std::vector<ABIParamDecoder> expectedDecoders{ABIParamDecoder::STRING, ABIParamDecoder::ADDR,
+        ABIParamDecoder::UINT256, ABIParamDecoder::INT256};
+    BOOST_CHECK(funcs[0]->getParamsDecoder() == expectedDecoders);
+
+    // find the function by the selector of the call data and decode the params
+    Address addr("0x6fe1a3b4f7c6e5d4c3b2a1908f7e6d5c4b3a2918");
+    auto callData = abi.abiIn(sig, std::string("test string"), addr, u256(111111111), s256(-1));
+    auto func = cache->getFuncBySelector(bytesConstRef(&callData));
+    BOOST_CHECK(func == funcs[0]);
+    std::vector<std::string> out;
+    BOOST_CHECK(abi.abiOutByFuncSelector(bytesConstRef(&callData).getCroppedData(4), *func, out));
+    std::vector<std::string> expectedOut{"test string", addr.hex(), "111111111", "-1"};
+    BOOST_CHECK(out == expectedOut);
+
+    // the same result with the type strings
+    std::vector<std::string> outByTypes;
+    BOOST_CHECK(abi.abiOutByFuncSelector(
+        bytesConstRef(&callData).getCroppedData(4), func->getParamsType(), outByTypes));
+    BOOST_CHECK(outByTypes == expectedOut);
+
+    // the unknown selector and the unsupported type
+    auto unknownCallData = abi.abiIn("unknown(uint256)", u256(1));
+    BOOST_CHECK(cache->getFuncBySelector(bytesConstRef(&unknownCallData)) == nullptr);
+    BOOST_CHECK(cache->getFuncBySelector(bytesConstRef(callData.data(), 3)) == nullptr);
+    auto boolFunc = cache->getFunc("set(bool)");
+    BOOST_CHECK(boolFunc->getParamsDecoder()[0] == ABIParamDecoder::UNSUPPORTED);
+    auto boolCallData = abi.abiIn("", true);
+    out.clear();
+    BOOST_CHECK(!abi.abiOutByFuncSelector(bytesConstRef(&boolCallData), *boolFunc, out));
+    BOOST_CHECK_EQUAL(cache->size(), 2);
+}
+
+// all the signatures are hashed into the same selector
+class CollidedHash : public bcos::crypto::Hash
+{
+public:
+    bcos::crypto::HashType hash(bytesConstRef) override { return bcos::crypto::HashType(1); }
+};
+
+BOOST_AUTO_TEST_CASE(testABIFuncCacheSelectorCollision)
+{
+    auto cache = std::make_shared<ABIFuncCache>(std::make_shared<CollidedHash>());
+    auto func = cache->getFunc("transfer(string,address,uint256,int256)");
+    BOOST_CHECK(func != nullptr);
+    BOOST_CHECK(cache->getFunc("transfer(string,address,uint256,int256)") == func);
+
+    // the function of another signature with the same selector is rejected
+    BOOST_CHECK(cache->getFunc("burn(uint256)") == nullptr);
+    BOOST_CHECK(cache->getFunc("burn(uint256)") == nullptr);
+    BOOST_CHECK_EQUAL(cache->size(), 1);
+    bytes callData(4, 0);
+    BOOST_CHECK(cache->getFuncBySelector(ref(callData)) == func);
+}
+
+BOOST_AUTO_TEST_CASE(testSharedCodec)
+{
+    // one codec is shared by all the threads, the decoding state is kept on the stack
+    auto hashImpl = std::make_shared<Keccak256Hash>();
+    const ContractABICodec abi(hashImpl);
+    std::atomic<size_t> failedCount{0};
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 8; i++)
+    {
+        threads.emplace_back([&, i]() {
+            for (size_t j = 0; j < 1000; j++)
+            {
+                u256 a(i * 1000 + j);
+                std::string b(i + j % 64, 'a' + i);
+                std::vector<std::string> c(j % 4, b);
+                auto encodedData = abi.abiIn("f(uint256,string,string[])", a, b, c);
+                u256 outA;
+                std::string outB;
+                std::vector<std::string> outC;
+                if (!abi.abiOut(
+                        bytesConstRef(&encodedData).getCroppedData(4), outA, outB, outC) ||
+                    outA != a || outB != b || outC != c)
+                {
+                    failedCount++;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    BOOST_CHECK_EQUAL(failedCount, 0);
+}
+
+BOOST_AUTO_TEST_CASE(testABIDecodeViews)
+{
+    auto hashImpl = std::make_shared<Keccak256Hash>();
+    ContractABICodec abi(hashImpl);
+    std::string s = "test string";
+    bytes b(1000, 0xab);
+    auto encodedData = abi.abiIn("", u256(1), s, b);
+
+    // the views borrow from the encoded data
+    u256 outU;
+    std::string_view outS;
+    bytesConstRef outB;
+    auto data = bytesConstRef(&encodedData);
+    BOOST_CHECK(abi.abiOut(data, outU, outS, outB));
+    BOOST_CHECK(outU == 1);
+    BOOST_CHECK_EQUAL(outS, s);
+    BOOST_CHECK(outB.toBytes() == b);
+    auto stringBegin = (byte const*)outS.data();
+    BOOST_CHECK(stringBegin > data.begin() && stringBegin + outS.size() < data.end());
+    BOOST_CHECK(outB.begin() > stringBegin && outB.end() <= data.end());
+
+    // the views are encoded as string and bytes
+    BOOST_CHECK(abi.abiIn("", outU, outS, outB) == encodedData);
+
+    // the invalid length reports the positions only
+    auto invalidData = encodedData;
+    invalidData[4 * 32 - 3] = 0xff;
+    BOOST_CHECK(!abi.abiOut(bytesConstRef(&invalidData), outU, outS, outB));
+    std::string message;
+    try
+    {
+        ContractABICodec::deserialize(bytesConstRef(&invalidData), outS, 3 * 32);
+    }
+    catch (std::length_error const& e)
+    {
+        message = e.what();
+    }
+    BOOST_CHECK(message.find("invalid length") != std::string::npos);
+    BOOST_CHECK(message.size() < 200);
+
+    // the length overflowing std::size_t
+    std::fill(invalidData.begin() + 3 * 32, invalidData.begin() + 4 * 32, 0xff);
+    BOOST_CHECK_THROW(ContractABICodec::deserialize(bytesConstRef(&invalidData), outB, 3 * 32),
+        std::length_error);
+    BOOST_CHECK_THROW(ContractABICodec::deserialize(data, outB, data.size()), std::length_error);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace bcos
\ No newline at end of file
@@ -0,0 +1,231 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief benchmark for the fused scale codec of the fixed-layout structs
+ * @file ScaleCodecPerf.cpp
+ */
+#include "../../../testutils/TestPromptFixture.h"
+#include "interfaces/protocol/ProtocolTypeDef.h"
+#include "libcodec/scale/Scale.h"
+#include <boost/test/unit_test.hpp>
+#include <functional>
+
+using namespace bcos;
+using namespace bcos::codec::scale;
+using namespace bcos::protocol;
+
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(ScaleCodecPerf, TestPromptFixture)
+
+// the hash fields of the block header
+struct HeaderHashFields
+{
+    ParentInfoList parentInfo;
+    h256 txsRoot;
+    h256 receiptsRoot;
+    h256 stateRoot;
+    BlockNumber number;
+    u256 gasUsed;
+    int64_t timestamp;
+    int64_t sealer;
+    std::vector<bytes> sealerList;
+    std::vector<uint64_t> consensusWeights;
+    bytes extraData;
+    BCOS_SCALE_FIELDS(parentInfo, txsRoot, receiptsRoot, stateRoot, number, gasUsed, timestamp,
+        sealer, sealerList, consensusWeights, extraData)
+};
+
+// the hash fields of the block header without the lists, all the fields are fixed
+struct FixedHeaderHashFields
+{
+    h256 txsRoot;
+    h256 receiptsRoot;
+    h256 stateRoot;
+    BlockNumber number;
+    u256 gasUsed;
+    int64_t timestamp;
+    int64_t sealer;
+    BCOS_SCALE_FIELDS(txsRoot, receiptsRoot, stateRoot, number, gasUsed, timestamp, sealer)
+};
+
+template <class T>
+void chainedEncode(ScaleEncoderStream& _stream, T const& _fields)
+{
+    _stream << _fields.txsRoot << _fields.receiptsRoot << _fields.stateRoot << _fields.number
+            << _fields.gasUsed << _fields.timestamp << _fields.sealer;
+}
+
+template <class T>
+void chainedDecode(ScaleDecoderStream& _stream, T& _fields)
+{
+    _stream >> _fields.txsRoot >> _fields.receiptsRoot >> _fields.stateRoot >> _fields.number >>
+        _fields.gasUsed >> _fields.timestamp >> _fields.sealer;
+}
+
+template <class T>
+void fillFields(T& _fields)
+{
+    _fields.txsRoot = h256(1);
+    _fields.receiptsRoot = h256(2);
+    _fields.stateRoot = h256(3);
+    _fields.number = 1000000;
+    _fields.gasUsed = u256("0x1234567890abcdef");
+    _fields.timestamp = utcTime();
+    _fields.sealer = 3;
+}
+
+// compare the chained operators with the fused codec, print the cost of every struct in ns
+template <class T>
+void benchmarkFields(std::string const& _name, T const& _fields,
+    std::function<void(ScaleEncoderStream&, T const&)> _chainedEncode,
+    std::function<void(ScaleDecoderStream&, T&)> _chainedDecode)
+{
+    size_t const round = 200000;
+    auto nanoSecondsPerStruct = [round](int64_t _us) { return (double)_us * 1000 / round; };
+
+    auto size = encodedSize(_fields);
+    bytes buffer(size);
+    auto startT = utcSteadyTimeUs();
+    for (size_t i = 0; i < round; i++)
+    {
+        ScaleEncoderStream stream{gsl::span<byte>(buffer)};
+        _chainedEncode(stream, _fields);
+    }
+    auto baselineEncodeCost = utcSteadyTimeUs() - startT;
+    auto expectedData = buffer;
+
+    startT = utcSteadyTimeUs();
+    for (size_t i = 0; i < round; i++)
+    {
+        ScaleEncoderStream stream{gsl::span<byte>(buffer)};
+        stream << _fields;
+    }
+    auto encodeCost = utcSteadyTimeUs() - startT;
+    BOOST_CHECK(buffer == expectedData);
+
+    T decodedFields;
+    startT = utcSteadyTimeUs();
+    for (size_t i = 0; i < round; i++)
+    {
+        ScaleDecoderStream stream{gsl::make_span(buffer)};
+        _chainedDecode(stream, decodedFields);
+    }
+    auto baselineDecodeCost = utcSteadyTimeUs() - startT;
+
+    startT = utcSteadyTimeUs();
+    for (size_t i = 0; i < round; i++)
+    {
+        ScaleDecoderStream stream{gsl::make_span(buffer)};
+        stream >> decodedFields;
+    }
+    auto decodeCost = utcSteadyTimeUs() - startT;
+    BOOST_CHECK(encode(decodedFields) == expectedData);
+
+    std::cout << "#### " << _name << "(" << size
+              << " bytes), encode before(ns): " << nanoSecondsPerStruct(baselineEncodeCost)
+              << ", after(ns): " << nanoSecondsPerStruct(encodeCost)
+              << ", decode before(ns): " << nanoSecondsPerStruct(baselineDecodeCost)
+              << ", after(ns): " << nanoSecondsPerStruct(decodeCost) << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(scaleFieldsPerf)
+{
+    FixedHeaderHashFields fixedFields;
+    fillFields(fixedFields);
+    benchmarkFields<FixedHeaderHashFields>("fixed header hash fields", fixedFields,
+        chainedEncode<FixedHeaderHashFields>, chainedDecode<FixedHeaderHashFields>);
+
+    HeaderHashFields fields;
+    fillFields(fields);
+    fields.parentInfo = {{999999, h256(4)}};
+    fields.sealerList = std::vector<bytes>(4, bytes(64, 0xab));
+    fields.consensusWeights = {1, 1, 1, 1};
+    fields.extraData = bytes(32, 0xcd);
+    benchmarkFields<HeaderHashFields>(
+        "header hash fields", fields,
+        [](ScaleEncoderStream& _stream, HeaderHashFields const& _fields) {
+            _stream << _fields.parentInfo;
+            chainedEncode(_stream, _fields);
+            _stream << _fields.sealerList << _fields.consensusWeights << _fields.extraData;
+        },
+        [](ScaleDecoderStream& _stream, HeaderHashFields& _fields) {
+            _stream >> _fields.parentInfo;
+            chainedDecode(_stream, _fields);
+            _stream >> _fields.sealerList >> _fields.consensusWeights >> _fields.extraData;
+        });
+}
+
+// compare the element-by-element decoding with the bulk decoding, print the throughput in MB/s
+template <class T>
+void benchmarkBulkDecode(std::string const& _name, std::vector<T> const& _items)
+{
+    size_t const round = 20;
+    auto megaBytesPerSecond = [round](size_t _bytes, int64_t _us) {
+        return _us == 0 ? 0 : (double)_bytes * round / _us;
+    };
+    auto encodedData = encode(_items);
+
+    std::vector<T> decodedItems;
+    auto startT = utcSteadyTimeUs();
+    for (size_t i = 0; i < round; i++)
+    {
+        ScaleDecoderStream stream{gsl::make_span(encodedData)};
+        CompactInteger size;
+        stream >> size;
+        decodedItems.resize(size.convert_to<size_t>());
+        for (auto& item : decodedItems)
+        {
+            stream >> item;
+        }
+    }
+    auto baselineDecodeCost = utcSteadyTimeUs() - startT;
+    BOOST_CHECK(decodedItems == _items);
+
+    startT = utcSteadyTimeUs();
+    for (size_t i = 0; i < round; i++)
+    {
+        decode(decodedItems, gsl::make_span(encodedData));
+    }
+    auto decodeCost = utcSteadyTimeUs() - startT;
+    BOOST_CHECK(decodedItems == _items);
+
+    std::cout << "#### " << _name << "(" << _items.size() << " items), decode before(MB/s): "
+              << megaBytesPerSecond(encodedData.size(), baselineDecodeCost)
+              << ", after(MB/s): " << megaBytesPerSecond(encodedData.size(), decodeCost)
+              << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(bulkDecodePerf)
+{
+    size_t const size = 1000000;
+    std::vector<uint64_t> weights(size);
+    std::vector<uint32_t> indexes(size);
+    h256s hashes(size);
+    for (size_t i = 0; i < size; i++)
+    {
+        weights[i] = i * 0x0102030405060708;
+        indexes[i] = i;
+        hashes[i] = h256(i);
+    }
+    benchmarkBulkDecode("uint64 vector", weights);
+    benchmarkBulkDecode("uint32 vector", indexes);
+    benchmarkBulkDecode("h256 vector", hashes);
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
@@ -17,6 +17,7 @@
 #include "libcodec/scale/Scale.h"
 #include "libcodec/scale/ScaleDecoderStream.h"
 #include "libcodec/scale/ScaleEncoderStream.h"
+#include "interfaces/protocol/ProtocolTypeDef.h"
 #include "libutilities/Common.h"
 #include "libutilities/DataConvertUtility.h"
 #include <boost/test/unit_test.hpp>
@@ -1071,6 +1072,344 @@ BOOST_AUTO_TEST_CASE(tests256)
     printData((s256)-123123122147483649);
     std::cout << "##### s256 test end" << std::endl;
 }
+
+BOOST_AUTO_TEST_CASE(testEncodeIntoCallerBuffer)
+{
+    // the collection sizes around the compact categories
+    for (size_t size : {0, 1, 63, 64, 16383, 16384})
+    {
+        bytes data(size, 0xab);
+        ScaleEncoderStream stream;
+        stream << data;
+        CompactInteger compactSize(size);
+        ScaleEncoderStream expectedStream;
+        expectedStream << compactSize;
+        auto expectedData = expectedStream.data();
+        expectedData.insert(expectedData.end(), data.begin(), data.end());
+        BOOST_CHECK(stream.data() == expectedData);
+        BOOST_CHECK_EQUAL(ScaleEncoderStream::encodedSize(data), expectedData.size());
+    }
+
+    u256 number = 3453456346534;
+    h256 hash(100);
+    std::string str = "scale";
+    std::vector<std::string> strList = {"a", "bc", ""};
+    std::vector<int64_t> numberList = {-1, 0, 1 << 20};
+    auto expectedData = encode(number, hash, str, strList, numberList, (int32_t)-5, true);
+    BOOST_CHECK_EQUAL(encodedSize(number, hash, str, strList, numberList, (int32_t)-5, true),
+        expectedData.size());
+
+    // append to the growable buffer owned by the caller
+    bytes buffer = {0x01, 0x02};
+    ScaleEncoderStream appendStream(buffer);
+    appendStream << number << hash << str << strList << numberList << (int32_t)-5 << true;
+    BOOST_CHECK_EQUAL(appendStream.size(), expectedData.size());
+    BOOST_CHECK(appendStream.data() == expectedData);
+    BOOST_CHECK(bytes(buffer.begin() + 2, buffer.end()) == expectedData);
+    BOOST_CHECK_EQUAL(buffer[0], 0x01);
+
+    // encode into the pb string field
+    std::string field;
+    encodeTo(field, number, hash, str, strList, numberList, (int32_t)-5, true);
+    BOOST_CHECK(bytes(field.begin(), field.end()) == expectedData);
+
+    // encode into the pre-sized span
+    bytes spanData(expectedData.size());
+    ScaleEncoderStream spanStream{gsl::span<byte>(spanData)};
+    spanStream << number << hash << str << strList << numberList << (int32_t)-5 << true;
+    BOOST_CHECK(spanData == expectedData);
+    BOOST_CHECK_THROW(spanStream << (uint8_t)1, ScaleEncodeException);
+
+    // decode back
+    ScaleDecoderStream decoder(gsl::make_span(spanData));
+    u256 decodedNumber;
+    h256 decodedHash;
+    std::string decodedStr;
+    std::vector<std::string> decodedStrList;
+    std::vector<int64_t> decodedNumberList;
+    int32_t decodedInt;
+    bool decodedBool;
+    decoder >> decodedNumber >> decodedHash >> decodedStr >> decodedStrList >> decodedNumberList >>
+        decodedInt >> decodedBool;
+    BOOST_CHECK(decodedNumber == number);
+    BOOST_CHECK(decodedHash == hash);
+    BOOST_CHECK_EQUAL(decodedStr, str);
+    BOOST_CHECK(decodedStrList == strList);
+    BOOST_CHECK(decodedNumberList == numberList);
+    BOOST_CHECK_EQUAL(decodedInt, -5);
+    BOOST_CHECK(decodedBool);
+}
+
+BOOST_AUTO_TEST_CASE(testDecodeViews)
+{
+    bytes payload(1000, 0xcd);
+    std::string str = "scale string";
+    u256 number("0x0102030405060708091011121314151617181920212223242526272829303132");
+    auto encodedData = encode(payload, str, number);
+
+    // the views refer to the source buffer
+    ScaleDecoderStream decoder(gsl::make_span(encodedData));
+    gsl::span<byte const> payloadView;
+    std::string_view strView;
+    u256 decodedNumber;
+    decoder >> payloadView >> strView >> decodedNumber;
+    BOOST_CHECK(payloadView.data() > encodedData.data() &&
+                payloadView.data() + payloadView.size() < encodedData.data() + encodedData.size());
+    BOOST_CHECK(bytes(payloadView.begin(), payloadView.end()) == payload);
+    BOOST_CHECK((byte const*)strView.data() > payloadView.data());
+    BOOST_CHECK_EQUAL(strView, str);
+    BOOST_CHECK(decodedNumber == number);
+    BOOST_CHECK(!decoder.hasMore(1));
+
+    // the copied values are the same with the views
+    ScaleDecoderStream copyDecoder(gsl::make_span(encodedData));
+    bytes decodedPayload;
+    std::string decodedStr;
+    copyDecoder >> decodedPayload >> decodedStr;
+    BOOST_CHECK(decodedPayload == payload);
+    BOOST_CHECK_EQUAL(decodedStr, str);
+
+    // the truncated data
+    for (size_t size : {(size_t)1, (size_t)500, encodedData.size() - 1})
+    {
+        ScaleDecoderStream truncatedDecoder(gsl::span<byte const>(encodedData.data(), size));
+        BOOST_CHECK_THROW(
+            truncatedDecoder >> payloadView >> strView >> decodedNumber, ScaleDecodeException);
+        ScaleDecoderStream truncatedCopyDecoder(gsl::span<byte const>(encodedData.data(), size));
+        BOOST_CHECK_THROW(truncatedCopyDecoder >> decodedPayload >> decodedStr >> decodedNumber,
+            ScaleDecodeException);
+    }
+}
+
+struct ScaleFieldsInner
+{
+    int64_t number;
+    h256 hash;
+    bool flag;
+    BCOS_SCALE_FIELDS(number, hash, flag)
+};
+
+struct ScaleFieldsOuter
+{
+    uint32_t version;
+    ScaleFieldsInner inner;
+    u256 value;
+    s256 signedValue;
+    std::string name;
+    std::vector<ScaleFieldsInner> inners;
+    FixedBytes<100> largeData;
+    uint16_t tail;
+    BCOS_SCALE_FIELDS(version, inner, value, signedValue, name, inners, largeData, tail)
+};
+
+BOOST_AUTO_TEST_CASE(testScaleFields)
+{
+    static_assert(FixedEncodedSize<ScaleFieldsInner>::value == 8 + 33 + 1);
+    static_assert(FixedEncodedSize<ScaleFieldsOuter>::value == 0);
+    static_assert(FixedEncodedSize<FixedBytes<100>>::value == 102);
+
+    ScaleFieldsOuter outer{10, {-3, h256(1234), true}, u256("0x112233445566778899"), s256(-7),
+        "scale fields", {{1, h256(1), false}, {2, h256(2), true}}, FixedBytes<100>(), 0xfffe};
+    outer.largeData[0] = 0xab;
+
+    // the fused codec encodes the same as the chained operators
+    ScaleEncoderStream expectedStream;
+    auto encodeInner = [&](ScaleFieldsInner const& _inner) {
+        expectedStream << _inner.number << _inner.hash << _inner.flag;
+    };
+    expectedStream << outer.version;
+    encodeInner(outer.inner);
+    expectedStream << outer.value << outer.signedValue << outer.name
+                   << CompactInteger(outer.inners.size());
+    for (auto const& inner : outer.inners)
+    {
+        encodeInner(inner);
+    }
+    expectedStream << outer.largeData << outer.tail;
+    auto expectedData = expectedStream.data();
+
+    auto encodedData = encode(outer);
+    BOOST_CHECK(encodedData == expectedData);
+    BOOST_CHECK_EQUAL(encodedSize(outer), expectedData.size());
+    ScaleEncoderStream stream;
+    stream << outer;
+    BOOST_CHECK(stream.data() == expectedData);
+
+    ScaleFieldsOuter decodedOuter;
+    decode(decodedOuter, gsl::make_span(encodedData));
+    BOOST_CHECK(encode(decodedOuter) == encodedData);
+    BOOST_CHECK_EQUAL(decodedOuter.inner.number, -3);
+    BOOST_CHECK(decodedOuter.inner.hash == h256(1234));
+    BOOST_CHECK(decodedOuter.signedValue == s256(-7));
+    BOOST_CHECK_EQUAL(decodedOuter.inners.size(), 2);
+    BOOST_CHECK_EQUAL(decodedOuter.tail, 0xfffe);
+
+    // the field list of the members
+    uint32_t version;
+    std::string name;
+    ScaleDecoderStream decoder(gsl::make_span(encodedData));
+    decoder >> makeFieldList(version, outer.inner);
+    BOOST_CHECK_EQUAL(version, 10);
+    BOOST_CHECK_EQUAL(decoder.currentIndex(), 4 + 42);
+
+    // the truncated data
+    for (size_t size = 0; size < encodedData.size(); size += 13)
+    {
+        ScaleDecoderStream truncatedDecoder(gsl::span<byte const>(encodedData.data(), size));
+        BOOST_CHECK_THROW(truncatedDecoder >> decodedOuter, ScaleDecodeException);
+    }
+    // the invalid bool
+    auto invalidData = encodedData;
+    invalidData[4 + 41] = 2;
+    BOOST_CHECK_THROW(decode(decodedOuter, gsl::make_span(invalidData)), ScaleDecodeException);
+    // the invalid length prefix of the FixedBytes
+    invalidData = encodedData;
+    invalidData[4 + 8] = 0;
+    BOOST_CHECK_THROW(decode(decodedOuter, gsl::make_span(invalidData)), ScaleDecodeException);
+}
+
+BOOST_AUTO_TEST_CASE(testScaleFieldsCanonicalPrefix)
+{
+    // the length 32 of h256 encoded in the two-byte mode instead of the single-byte mode
+    ScaleEncoderStream stream;
+    stream << (int64_t)-3;
+    bytes nonCanonicalData = stream.data();
+    nonCanonicalData.push_back((32 << 2) + 1);
+    nonCanonicalData.push_back(0);
+    auto hash = h256(1234);
+    nonCanonicalData.insert(nonCanonicalData.end(), hash.begin(), hash.end());
+    nonCanonicalData.push_back(1);
+
+    // the chained operators accept the non-canonical length prefix
+    int64_t number;
+    h256 decodedHash;
+    bool flag;
+    ScaleDecoderStream decoder(gsl::make_span(nonCanonicalData));
+    decoder >> number >> decodedHash >> flag;
+    BOOST_CHECK(decodedHash == hash);
+    // the fused field list only accepts the canonical one, which is the only one encoded
+    ScaleFieldsInner inner;
+    BOOST_CHECK_THROW(decode(inner, gsl::make_span(nonCanonicalData)), ScaleDecodeException);
+    inner = {number, decodedHash, flag};
+    auto canonicalData = encode(inner);
+    BOOST_CHECK_EQUAL(canonicalData.size(), nonCanonicalData.size() - 1);
+    decode(inner, gsl::make_span(canonicalData));
+    BOOST_CHECK(inner.hash == hash);
+
+    // the structs of the interfaces declare the fields by BCOS_SCALE_FIELDS
+    bcos::protocol::ParentInfo parentInfo{10, hash};
+    ScaleEncoderStream parentInfoStream;
+    parentInfoStream << parentInfo.blockNumber << parentInfo.blockHash;
+    BOOST_CHECK(encode(parentInfo) == parentInfoStream.data());
+    static_assert(FixedEncodedSize<bcos::protocol::ParentInfo>::value == 8 + 33);
+
+    // the streams encode and decode them the same as the chained fields
+    bcos::protocol::SignatureList signatureList = {{1, bytes(65, 1)}, {2, bytes(64, 2)}};
+    ScaleEncoderStream signatureStream;
+    signatureStream << signatureList << parentInfo;
+    ScaleEncoderStream fieldsStream;
+    fieldsStream << CompactInteger(signatureList.size());
+    for (auto const& signature : signatureList)
+    {
+        fieldsStream << signature.index << signature.signature;
+    }
+    fieldsStream << parentInfo.blockNumber << parentInfo.blockHash;
+    BOOST_CHECK(signatureStream.data() == fieldsStream.data());
+    bcos::protocol::SignatureList decodedSignatureList;
+    bcos::protocol::ParentInfo decodedParentInfo;
+    auto signatureData = signatureStream.data();
+    ScaleDecoderStream signatureDecoder(gsl::make_span(signatureData));
+    signatureDecoder >> decodedSignatureList >> decodedParentInfo;
+    BOOST_CHECK_EQUAL(decodedSignatureList.size(), signatureList.size());
+    for (size_t i = 0; i < signatureList.size(); i++)
+    {
+        BOOST_CHECK_EQUAL(decodedSignatureList[i].index, signatureList[i].index);
+        BOOST_CHECK(decodedSignatureList[i].signature == signatureList[i].signature);
+    }
+    BOOST_CHECK(decodedParentInfo == parentInfo);
+}
+
+template <class T>
+void checkBulkDecode(std::vector<T> const& _items)
+{
+    auto encodedData = encode(_items);
+    // the items decoded in bulk are the same with the items decoded one by one
+    std::vector<T> decodedItems;
+    decode(decodedItems, gsl::make_span(encodedData));
+    BOOST_CHECK(decodedItems == _items);
+
+    ScaleDecoderStream stream(gsl::make_span(encodedData));
+    CompactInteger size;
+    stream >> size;
+    BOOST_CHECK(size == _items.size());
+    for (auto const& item : _items)
+    {
+        T decodedItem;
+        stream >> decodedItem;
+        BOOST_CHECK(decodedItem == item);
+    }
+    BOOST_CHECK(!stream.hasMore(1));
+
+    // the truncated data
+    if (!_items.empty())
+    {
+        BOOST_CHECK_THROW(
+            decode(decodedItems, gsl::span<byte const>(encodedData.data(), encodedData.size() - 1)),
+            ScaleDecodeException);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testBulkDecodeVectors)
+{
+    for (size_t size : {0, 1, 7, 64, 1000})
+    {
+        std::vector<uint16_t> uint16Items;
+        std::vector<int32_t> int32Items;
+        std::vector<uint64_t> uint64Items;
+        std::vector<int64_t> int64Items;
+        h256s hashes;
+        std::vector<FixedBytes<100>> largeItems;
+        for (size_t i = 0; i < size; i++)
+        {
+            uint16Items.emplace_back(i * 0x0101);
+            int32Items.emplace_back(-(int32_t)i * 0x01020304);
+            uint64Items.emplace_back(i * 0x0102030405060708);
+            int64Items.emplace_back(-(int64_t)i * 0x0102030405060708);
+            hashes.emplace_back(h256(i * 0x0102030405060708));
+            largeItems.emplace_back();
+            largeItems.back()[i % 100] = i & 0xff;
+        }
+        checkBulkDecode(uint16Items);
+        checkBulkDecode(int32Items);
+        checkBulkDecode(uint64Items);
+        checkBulkDecode(int64Items);
+        checkBulkDecode(hashes);
+        checkBulkDecode(largeItems);
+    }
+    // the integers decoded by the fixed width codec
+    bytes encodedData = {0xfe, 0xff, 0xff, 0xff, 0x34, 0x12};
+    ScaleDecoderStream stream(gsl::make_span(encodedData));
+    int32_t int32Value;
+    uint16_t uint16Value;
+    stream >> int32Value >> uint16Value;
+    BOOST_CHECK_EQUAL(int32Value, -2);
+    BOOST_CHECK_EQUAL(uint16Value, 0x1234);
+    BOOST_CHECK_THROW(stream >> uint16Value, ScaleDecodeException);
+
+    // the items count exceeds the remaining data, rejected before the allocation
+    ScaleEncoderStream encoder;
+    encoder << CompactInteger(std::numeric_limits<uint32_t>::max()) << (uint64_t)1;
+    encodedData = encoder.data();
+    std::vector<uint64_t> uint64Items;
+    BOOST_CHECK_THROW(decode(uint64Items, gsl::make_span(encodedData)), ScaleDecodeException);
+    h256s hashes;
+    BOOST_CHECK_THROW(decode(hashes, gsl::make_span(encodedData)), ScaleDecodeException);
+
+    // the invalid length prefix of the hash
+    encodedData = encode(h256s{h256(1), h256(2)});
+    encodedData[1 + 33] = (31 << 2);
+    BOOST_CHECK_THROW(decode(hashes, gsl::make_span(encodedData)), ScaleDecodeException);
+}
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace bcos
@@ -0,0 +1,71 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for BlockColumns
+ * @file BlockColumnsTest.cpp
+ */
+#include "libprotocol/BlockColumns.h"
+#include "../../../testutils/TestPromptFixture.h"
+#include "testutils/protocol/FakeBlock.h"
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::protocol;
+using namespace bcos::crypto;
+
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(BlockColumnsTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(testBlockColumns)
+{
+    auto cryptoSuite = createNormalCryptoSuite();
+    auto blockFactory = createBlockFactory(cryptoSuite);
+    auto block = fakeAndCheckBlock(cryptoSuite, blockFactory, true, 50, 50);
+    bytes encodedData;
+    block->encode(encodedData);
+    auto decodedBlock = blockFactory->createBlock(encodedData);
+
+    BlockColumns columns(*decodedBlock);
+    BOOST_CHECK_EQUAL(columns.transactionsSize(), 50);
+    BOOST_CHECK_EQUAL(columns.receiptsSize(), 50);
+    BOOST_CHECK_EQUAL(columns.senders().size(), 50);
+    BOOST_CHECK_EQUAL(columns.to().size(), 50);
+    for (size_t i = 0; i < columns.transactionsSize(); i++)
+    {
+        auto tx = decodedBlock->transaction(i);
+        BOOST_CHECK_EQUAL(columns.transactionsHash()[i], tx->hash());
+        BOOST_CHECK(columns.senders()[i] == tx->sender());
+        BOOST_CHECK(columns.to()[i] == tx->to());
+    }
+    for (size_t i = 0; i < columns.receiptsSize(); i++)
+    {
+        auto receipt = decodedBlock->receipt(i);
+        BOOST_CHECK_EQUAL(columns.status()[i], receipt->status());
+        BOOST_CHECK(columns.gasUsed()[i] == receipt->gasUsed());
+        BOOST_CHECK_EQUAL(columns.logEntriesSize()[i], receipt->logEntries().size());
+    }
+
+    // the empty block
+    BlockColumns emptyColumns(*blockFactory->createBlock());
+    BOOST_CHECK_EQUAL(emptyColumns.transactionsSize(), 0);
+    BOOST_CHECK_EQUAL(emptyColumns.senders().size(), 0);
+    BOOST_CHECK_EQUAL(emptyColumns.receiptsSize(), 0);
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
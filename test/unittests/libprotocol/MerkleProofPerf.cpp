@@ -0,0 +1,106 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief benchmark for the merkle root calculation
+ * @file MerkleProofPerf.cpp
+ */
+#include "../../../testutils/TestPromptFixture.h"
+#include "libcodec/scale/ScaleEncoderStream.h"
+#include "libprotocol/ParallelMerkleProof.h"
+#include "testutils/protocol/FakeBlock.h"
+#include <tbb/parallel_for.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::protocol;
+using namespace bcos::crypto;
+
+namespace bcos
+{
+namespace test
+{
+// the merkle root calculation that allocates the level list and the children data per node,
+// used as the baseline of the benchmark
+HashType calculateMerkleProofRootWithAllocation(
+    CryptoSuite::Ptr _cryptoSuite, std::vector<bytes> _bytesCaches)
+{
+    if (_bytesCaches.empty())
+    {
+        return _cryptoSuite->hash(bytes());
+    }
+    while (_bytesCaches.size() > 1)
+    {
+        std::vector<bytes> higherLevelList;
+        size_t size = (_bytesCaches.size() + MERKLE_MAX_CHILD_COUNT - 1) / MERKLE_MAX_CHILD_COUNT;
+        higherLevelList.resize(size);
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, size), [&](const tbb::blocked_range<size_t>& _r) {
+                for (auto i = _r.begin(); i < _r.end(); ++i)
+                {
+                    bytes byteValue;
+                    for (size_t j = 0; j < MERKLE_MAX_CHILD_COUNT; j++)
+                    {
+                        auto index = i * MERKLE_MAX_CHILD_COUNT + j;
+                        if (index < _bytesCaches.size())
+                        {
+                            byteValue.insert(byteValue.end(), _bytesCaches[index].begin(),
+                                _bytesCaches[index].end());
+                        }
+                    }
+                    higherLevelList[i] = _cryptoSuite->hash(byteValue).asBytes();
+                }
+            });
+        _bytesCaches = std::move(higherLevelList);
+    }
+    return _cryptoSuite->hash(_bytesCaches[0]);
+}
+
+BOOST_FIXTURE_TEST_SUITE(MerkleProofPerf, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(calculateMerkleProofRootPerf)
+{
+    auto cryptoSuite = createNormalCryptoSuite();
+    for (size_t leavesSize : {10 * 1000, 100 * 1000, 1000 * 1000})
+    {
+        // the leaf is the compact encoded index with the hash
+        std::vector<bytes> leaves(leavesSize);
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, leavesSize),
+            [&](const tbb::blocked_range<size_t>& _r) {
+                for (auto i = _r.begin(); i < _r.end(); ++i)
+                {
+                    bcos::codec::scale::ScaleEncoderStream stream;
+                    stream << i;
+                    leaves[i] = stream.data();
+                    auto hash = HashType(i);
+                    leaves[i].insert(leaves[i].end(), hash.begin(), hash.end());
+                }
+            });
+
+        auto startT = utcSteadyTimeUs();
+        auto expectedRoot = calculateMerkleProofRootWithAllocation(cryptoSuite, leaves);
+        auto baselineCost = utcSteadyTimeUs() - startT;
+
+        startT = utcSteadyTimeUs();
+        auto root = calculateMerkleProofRoot(cryptoSuite, leaves);
+        auto cost = utcSteadyTimeUs() - startT;
+
+        BOOST_CHECK_EQUAL(root, expectedRoot);
+        std::cout << "#### calculateMerkleProofRoot, leaves: " << leavesSize
+                  << ", before(us): " << baselineCost << ", after(us): " << cost << std::endl;
+    }
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
@@ -0,0 +1,249 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for MerkleTree
+ * @file MerkleTreeTest.cpp
+ */
+#include "libprotocol/MerkleTree.h"
+#include "../../../testutils/TestPromptFixture.h"
+#include "libcodec/scale/ScaleEncoderStream.h"
+#include "libprotocol/ParallelMerkleProof.h"
+#include "libprotocol/protobuf/PBBlock.h"
+#include "testutils/protocol/FakeBlock.h"
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::protocol;
+using namespace bcos::crypto;
+
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(MerkleTreeTest, TestPromptFixture)
+
+std::vector<bytes> fakeMerkleLeaves(Hash::Ptr _hashImpl, size_t _size, size_t _seed = 0)
+{
+    std::vector<bytes> leaves;
+    for (size_t i = 0; i < _size; i++)
+    {
+        leaves.emplace_back(_hashImpl->hash(std::to_string(i + _seed)).asBytes());
+    }
+    return leaves;
+}
+
+BOOST_AUTO_TEST_CASE(testMerkleTreeRoot)
+{
+    auto cryptoSuite = createNormalCryptoSuite();
+    auto hashImpl = cryptoSuite->hashImpl();
+    for (size_t size : {0, 1, 2, 15, 16, 17, 255, 256, 257, 1000})
+    {
+        auto leaves = fakeMerkleLeaves(hashImpl, size);
+        MerkleTree tree(hashImpl, fakeMerkleLeaves(hashImpl, size));
+        BOOST_CHECK_EQUAL(tree.leavesSize(), size);
+        BOOST_CHECK_EQUAL(tree.root(), calculateMerkleProofRoot(cryptoSuite, leaves));
+
+        // the leaves encoded into one buffer
+        bytes encodedLeaves;
+        for (auto const& leaf : leaves)
+        {
+            encodedLeaves.insert(encodedLeaves.end(), leaf.begin(), leaf.end());
+        }
+        BOOST_CHECK_EQUAL(
+            tree.root(), calculateMerkleProofRoot(cryptoSuite, ref(encodedLeaves), HashType::size));
+        MerkleTree encodedTree(hashImpl, ref(encodedLeaves), HashType::size);
+        BOOST_CHECK_EQUAL(encodedTree.leavesSize(), size);
+        BOOST_CHECK_EQUAL(encodedTree.root(), tree.root());
+
+        // build the tree incrementally
+        MerkleTree appendedTree(hashImpl);
+        for (auto leaf : fakeMerkleLeaves(hashImpl, size))
+        {
+            appendedTree.appendLeaf(std::move(leaf));
+        }
+        BOOST_CHECK_EQUAL(appendedTree.root(), tree.root());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testUpdateMerkleLeaf)
+{
+    auto hashImpl = createNormalCryptoSuite()->hashImpl();
+    auto leaves = fakeMerkleLeaves(hashImpl, 300);
+    MerkleTree tree(hashImpl, fakeMerkleLeaves(hashImpl, 300));
+    auto updatedLeaves = fakeMerkleLeaves(hashImpl, 3, 1000);
+    for (size_t index : {0, 17, 299})
+    {
+        leaves[index] = updatedLeaves.back();
+        tree.updateLeaf(index, std::move(updatedLeaves.back()));
+        updatedLeaves.pop_back();
+        MerkleTree expectedTree(hashImpl, std::vector<bytes>(leaves));
+        BOOST_CHECK_EQUAL(tree.root(), expectedTree.root());
+    }
+    BOOST_CHECK_THROW(tree.updateLeaf(300, bytes()), MerkleLeafIndexOutOfRange);
+}
+
+BOOST_AUTO_TEST_CASE(testMerkleProof)
+{
+    auto hashImpl = createNormalCryptoSuite()->hashImpl();
+    for (size_t size : {1, 2, 16, 17, 300})
+    {
+        auto leaves = fakeMerkleLeaves(hashImpl, size);
+        MerkleTree tree(hashImpl, fakeMerkleLeaves(hashImpl, size));
+        auto root = tree.root();
+        for (size_t index : {(size_t)0, size / 2, size - 1})
+        {
+            auto proof = tree.generateProof(index);
+            BOOST_CHECK(MerkleTree::verifyProof(hashImpl, proof, ref(leaves[index]), root));
+            // mismatched leaf
+            auto fakeLeaf = hashImpl->hash(std::string("fake")).asBytes();
+            BOOST_CHECK(!MerkleTree::verifyProof(hashImpl, proof, ref(fakeLeaf), root));
+
+            // encode and decode the proof
+            auto encodedProof = proof.encode();
+            MerkleProof decodedProof;
+            decodedProof.decode(ref(encodedProof));
+            BOOST_CHECK_EQUAL(decodedProof.leafIndex, index);
+            BOOST_CHECK(decodedProof.siblingLeaves == proof.siblingLeaves);
+            BOOST_CHECK(decodedProof.siblingHashes == proof.siblingHashes);
+            BOOST_CHECK(
+                MerkleTree::verifyProof(hashImpl, decodedProof, ref(leaves[index]), root));
+
+            // mismatched leaf index
+            if (size > 1)
+            {
+                decodedProof.leafIndex = (index == 0 ? 1 : 0);
+                BOOST_CHECK(
+                    !MerkleTree::verifyProof(hashImpl, decodedProof, ref(leaves[index]), root));
+            }
+        }
+    }
+    // only log16(n) siblings are kept
+    MerkleTree largeTree(hashImpl, fakeMerkleLeaves(hashImpl, 4096));
+    auto proof = largeTree.generateProof(100);
+    BOOST_CHECK_EQUAL(proof.siblingLeaves.size(), 15);
+    BOOST_CHECK_EQUAL(proof.siblingHashes.size(), 2);
+
+    MerkleTree tree(hashImpl, fakeMerkleLeaves(hashImpl, 10));
+    BOOST_CHECK_THROW(tree.generateProof(10), MerkleLeafIndexOutOfRange);
+}
+
+BOOST_AUTO_TEST_CASE(testParent2ChildList)
+{
+    auto cryptoSuite = createNormalCryptoSuite();
+    auto hashImpl = cryptoSuite->hashImpl();
+    for (size_t size : {1, 2, 16, 17, 300})
+    {
+        auto leaves = fakeMerkleLeaves(hashImpl, size);
+        auto parent2ChildList = std::make_shared<std::map<std::string, std::vector<std::string>>>();
+        calculateMerkleProof(cryptoSuite, leaves, parent2ChildList);
+        // the leaves are not consumed
+        BOOST_CHECK(leaves == fakeMerkleLeaves(hashImpl, size));
+
+        auto root = calculateMerkleProofRoot(cryptoSuite, leaves);
+        BOOST_CHECK(parent2ChildList->count(root.hex()));
+        size_t leavesCount = 0;
+        for (auto const& it : *parent2ChildList)
+        {
+            bytes childrenData;
+            for (auto const& child : it.second)
+            {
+                auto childData = fromHexString(child);
+                childrenData.insert(childrenData.end(), childData->begin(), childData->end());
+                leavesCount += std::count(leaves.begin(), leaves.end(), *childData);
+            }
+            BOOST_CHECK_EQUAL(hashImpl->hash(childrenData).hex(), it.first);
+        }
+        BOOST_CHECK_EQUAL(leavesCount, size);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testBlockMerkleTreeCache)
+{
+    auto cryptoSuite = createNormalCryptoSuite();
+    auto blockFactory = createBlockFactory(cryptoSuite);
+    auto block = std::dynamic_pointer_cast<PBBlock>(blockFactory->createBlock());
+    // build the trees with no leaves
+    BOOST_CHECK_THROW(block->transactionProof(0), MerkleLeafIndexOutOfRange);
+    BOOST_CHECK_THROW(block->receiptProof(0), MerkleLeafIndexOutOfRange);
+
+    Transactions txs;
+    Receipts receipts;
+    auto merkleLeaf = [](size_t _index, HashType const& _hash) {
+        // the leaf is the SCALE encoded index with the hash
+        bcos::codec::scale::ScaleEncoderStream stream;
+        stream << _index;
+        auto leaf = stream.data();
+        leaf.insert(leaf.end(), _hash.begin(), _hash.end());
+        return leaf;
+    };
+    auto checkRoots = [&]() {
+        auto expectedBlock = blockFactory->createBlock();
+        for (size_t i = 0; i < txs.size(); i++)
+        {
+            expectedBlock->appendTransaction(txs[i]);
+            expectedBlock->appendReceipt(receipts[i]);
+        }
+        auto txsRoot = block->calculateTransactionRoot();
+        auto receiptsRoot = block->calculateReceiptRoot();
+        BOOST_CHECK_EQUAL(txsRoot, expectedBlock->calculateTransactionRoot());
+        BOOST_CHECK_EQUAL(receiptsRoot, expectedBlock->calculateReceiptRoot());
+        // the proofs are generated from the updated trees
+        for (size_t i = 0; i < txs.size(); i += 7)
+        {
+            auto txLeaf = merkleLeaf(i, txs[i]->hash());
+            BOOST_CHECK(MerkleTree::verifyProof(
+                cryptoSuite->hashImpl(), block->transactionProof(i), ref(txLeaf), txsRoot));
+            auto receiptLeaf = merkleLeaf(i, receipts[i]->hash());
+            BOOST_CHECK(MerkleTree::verifyProof(
+                cryptoSuite->hashImpl(), block->receiptProof(i), ref(receiptLeaf), receiptsRoot));
+        }
+    };
+    for (size_t i = 0; i < 20; i++)
+    {
+        auto lastTxsRoot = block->calculateTransactionRoot();
+        txs.emplace_back(fakeTransaction(cryptoSuite, utcTime() + i));
+        receipts.emplace_back(testPBTransactionReceipt(cryptoSuite));
+        // the cached trees are updated in place
+        block->appendTransaction(txs.back());
+        block->appendReceipt(receipts.back());
+        BOOST_CHECK(block->calculateTransactionRoot() != lastTxsRoot);
+        BOOST_CHECK_THROW(block->transactionProof(txs.size()), MerkleLeafIndexOutOfRange);
+        checkRoots();
+    }
+    // update the transaction and the receipt
+    auto lastTxsRoot = block->calculateTransactionRoot();
+    txs[3] = fakeTransaction(cryptoSuite, utcTime() + 100);
+    receipts[3] = testPBTransactionReceipt(cryptoSuite);
+    block->setTransaction(3, txs[3]);
+    block->setReceipt(3, receipts[3]);
+    checkRoots();
+    BOOST_CHECK(block->calculateTransactionRoot() != lastTxsRoot);
+
+    std::vector<bytes> expectedLeaves;
+    for (size_t i = 0; i < txs.size(); i++)
+    {
+        expectedLeaves.emplace_back(merkleLeaf(i, txs[i]->hash()));
+    }
+    BOOST_CHECK_EQUAL(
+        block->calculateTransactionRoot(), calculateMerkleProofRoot(cryptoSuite, expectedLeaves));
+    // the proof of the updated transaction
+    BOOST_CHECK(MerkleTree::verifyProof(cryptoSuite->hashImpl(), block->transactionProof(3),
+        ref(expectedLeaves[3]), block->calculateTransactionRoot()));
+    BOOST_CHECK(!MerkleTree::verifyProof(cryptoSuite->hashImpl(), block->transactionProof(4),
+        ref(expectedLeaves[3]), block->calculateTransactionRoot()));
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
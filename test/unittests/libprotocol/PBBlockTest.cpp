@@ -144,6 +144,137 @@ BOOST_AUTO_TEST_CASE(testSMBlock)
     auto blockFactory = createBlockFactory(cryptoSuite);
     testBlock(cryptoSuite, blockFactory);
 }
+
+BOOST_AUTO_TEST_CASE(testLazyDecodeBlock)
+{
+    auto cryptoSuite = createNormalCryptoSuite();
+    auto blockFactory = createBlockFactory(cryptoSuite);
+    auto block = fakeAndCheckBlock(cryptoSuite, blockFactory, true, 10, 10);
+    NonceList nonceList;
+    for (int i = 0; i < 10; i++)
+    {
+        nonceList.push_back(u256(i + utcTime()));
+    }
+    block->setNonceList(nonceList);
+    bytes encodedData;
+    block->encode(encodedData);
+
+    // re-encode without decoding any field
+    auto lazyBlock = blockFactory->createBlockLazily(ref(encodedData));
+    bytes reEncodedData;
+    lazyBlock->encode(reEncodedData);
+    BOOST_CHECK(reEncodedData == encodedData);
+
+    // decode the fields on demand
+    lazyBlock = blockFactory->createBlockLazily(ref(encodedData));
+    BOOST_CHECK_EQUAL(lazyBlock->blockHeaderConst()->hash(), block->blockHeaderConst()->hash());
+    BOOST_CHECK_EQUAL(lazyBlock->transactionsSize(), block->transactionsSize());
+    BOOST_CHECK_EQUAL(lazyBlock->transaction(3)->hash(), block->transaction(3)->hash());
+    BOOST_CHECK_EQUAL(lazyBlock->receipt(5)->hash(), block->receipt(5)->hash());
+    BOOST_CHECK(lazyBlock->transaction(10) == nullptr);
+    BOOST_CHECK(lazyBlock->transactionMetaData(3)->hash() == block->transaction(3)->hash());
+    BOOST_CHECK(lazyBlock->nonceList() == nonceList);
+    checkBlock(cryptoSuite, block, lazyBlock);
+
+    // update the lazily decoded block
+    lazyBlock = blockFactory->createBlockLazily(ref(encodedData));
+    auto tx = fakeTransaction(cryptoSuite, utcTime() + 100);
+    lazyBlock->setTransaction(0, tx);
+    lazyBlock->encode(reEncodedData);
+    auto decodedBlock = blockFactory->createBlock(reEncodedData);
+    BOOST_CHECK_EQUAL(decodedBlock->transactionsSize(), 10);
+    BOOST_CHECK_EQUAL(decodedBlock->transaction(0)->hash(), tx->hash());
+    BOOST_CHECK_EQUAL(decodedBlock->transaction(9)->hash(), block->transaction(9)->hash());
+}
+BOOST_AUTO_TEST_CASE(testBlockNonces)
+{
+    auto cryptoSuite = createNormalCryptoSuite();
+    auto blockFactory = createBlockFactory(cryptoSuite);
+    auto block = blockFactory->createBlock();
+    NonceList nonceList = {u256(0), u256(1), u256(utcTime()), u256(-1)};
+    block->setNonceList(nonceList);
+    bytes encodedData;
+    block->encode(encodedData);
+    auto decodedBlock = blockFactory->createBlock(encodedData);
+    BOOST_CHECK(decodedBlock->nonceList() == nonceList);
+
+    // the nonces of the transactions are cached until the transactions are updated
+    for (size_t i = 0; i < 5; i++)
+    {
+        block->appendTransaction(fakeTransaction(cryptoSuite, utcTime() + i));
+    }
+    auto nonces = block->cachedNonces();
+    BOOST_CHECK_EQUAL(nonces->size(), 5);
+    BOOST_CHECK(nonces == block->cachedNonces());
+    // the shared nonces can't be modified by the callers
+    static_assert(std::is_const_v<std::remove_reference_t<decltype(*nonces)>>,
+        "the cached nonces should be immutable");
+    for (size_t i = 0; i < 5; i++)
+    {
+        BOOST_CHECK((*nonces)[i] == block->transaction(i)->nonce());
+    }
+    // nonces() hands out a copy owned by the caller
+    auto ownedNonces = block->nonces();
+    BOOST_CHECK(*ownedNonces == *nonces);
+    ownedNonces->clear();
+    BOOST_CHECK_EQUAL(block->cachedNonces()->size(), 5);
+    BOOST_CHECK_EQUAL(block->nonces()->size(), 5);
+
+    block->appendTransaction(fakeTransaction(cryptoSuite, utcTime() + 5));
+    BOOST_CHECK_EQUAL(block->cachedNonces()->size(), 6);
+    BOOST_CHECK(block->cachedNonces()->back() == block->transaction(5)->nonce());
+}
+BOOST_AUTO_TEST_CASE(testBlockEncodeWithUnknownFields)
+{
+    auto cryptoSuite = createNormalCryptoSuite();
+    auto blockFactory = createBlockFactory(cryptoSuite);
+    // the unknown fields: the header and the transactions with mismatched wire types, field 9
+    // and field 12
+    bytes unknownFields = {(1 << 3) | 0, 1, (2 << 3) | 0, 5, (9 << 3) | 0, 100, (12 << 3) | 2, 3,
+        'a', 'b', 'c'};
+    for (bool withTrailingFields : {false, true})
+    {
+        auto block = blockFactory->createBlock();
+        auto blockHeader = blockFactory->blockHeaderFactory()->createBlockHeader();
+        blockHeader->setNumber(10);
+        block->setBlockHeader(blockHeader);
+        if (withTrailingFields)
+        {
+            // the fields behind the transactions and the receipts
+            block->setVersion(3);
+            block->setNonceList(NonceList({u256(1), u256(2)}));
+        }
+        bytes encodedData;
+        block->encode(encodedData);
+        encodedData.insert(encodedData.end(), unknownFields.begin(), unknownFields.end());
+
+        // the block with the unknown fields and the transactions and receipts not cached
+        auto decodedBlock = blockFactory->createBlock(encodedData);
+        PBRawBlock expectedPBBlock;
+        BOOST_CHECK(expectedPBBlock.ParseFromArray(encodedData.data(), encodedData.size()));
+        for (size_t i = 0; i < 3; i++)
+        {
+            decodedBlock->appendTransaction(fakeTransaction(cryptoSuite, utcTime() + i));
+            decodedBlock->appendReceipt(testPBTransactionReceipt(cryptoSuite));
+            auto encodedTx = decodedBlock->transaction(i)->encode(false);
+            expectedPBBlock.add_transactions(encodedTx.data(), encodedTx.size());
+            auto encodedReceipt = decodedBlock->receipt(i)->encode(false);
+            expectedPBBlock.add_receipts(encodedReceipt.data(), encodedReceipt.size());
+        }
+        bytes expectedData(expectedPBBlock.ByteSizeLong());
+        expectedPBBlock.SerializeToArray(expectedData.data(), expectedData.size());
+
+        // the same as serializing the block with all the fields
+        bytes reencodedData;
+        decodedBlock->encode(reencodedData);
+        BOOST_CHECK(reencodedData == expectedData);
+        auto reencodedBlock = blockFactory->createBlock(reencodedData);
+        BOOST_CHECK_EQUAL(reencodedBlock->transactionsSize(), 3);
+        BOOST_CHECK_EQUAL(reencodedBlock->receiptsSize(), 3);
+        BOOST_CHECK_EQUAL(reencodedBlock->blockHeader()->number(), 10);
+        BOOST_CHECK(reencodedBlock->nonceList() == block->nonceList());
+    }
+}
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace bcos
\ No newline at end of file
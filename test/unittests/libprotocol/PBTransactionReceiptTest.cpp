@@ -20,6 +20,7 @@
  */
 #include "../../../testutils/TestPromptFixture.h"
 #include "libprotocol/Common.h"
+#include "libprotocol/protobuf/PBTransactionReceiptFactory.h"
 #include "testutils/protocol/FakeTransactionReceipt.h"
 
 using namespace bcos;
@@ -148,6 +149,77 @@ BOOST_AUTO_TEST_CASE(testSMPBTransactionRecept)
         std::make_shared<PBTransactionReceipt>(cryptoSuite, *receiptData), PBObjectDecodeException);
 #endif
 }
+BOOST_AUTO_TEST_CASE(testPooledReceiptFactory)
+{
+    auto hashImpl = std::make_shared<Keccak256Hash>();
+    auto cryptoSuite = std::make_shared<CryptoSuite>(hashImpl, nullptr, nullptr);
+    auto factory = std::make_shared<PBTransactionReceiptFactory>(cryptoSuite, 10);
+
+    auto receipt = testPBTransactionReceipt(cryptoSuite);
+    auto encodedData = receipt->encode(false).toBytes();
+    for (size_t i = 0; i < 5; i++)
+    {
+        auto decodedReceipt = factory->createReceipt(encodedData);
+        checkReceipts(hashImpl, receipt, decodedReceipt);
+    }
+    BOOST_CHECK_EQUAL(factory->pool()->allocatedCount(), 1);
+    BOOST_CHECK_EQUAL(factory->pool()->reusedCount(), 4);
+    BOOST_CHECK_EQUAL(factory->pool()->controlBlockAllocatedCount(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(testDecodedReceiptOutputNotCopied)
+{
+    auto hashImpl = std::make_shared<Keccak256Hash>();
+    auto cryptoSuite = std::make_shared<CryptoSuite>(hashImpl, nullptr, nullptr);
+    auto factory = std::make_shared<PBTransactionReceiptFactory>(cryptoSuite);
+    auto receipt = testPBTransactionReceipt(cryptoSuite);
+    auto encodedData = receipt->encode(false).toBytes();
+
+    auto decodedReceipt = factory->createReceipt(encodedData);
+    checkReceipts(hashImpl, receipt, decodedReceipt);
+    // the output refers to the hash fields data of the decoded receipt
+    auto hashFieldsData = decodedReceipt->encode(true);
+    auto output = decodedReceipt->output();
+    BOOST_CHECK(output.size() > 0);
+    BOOST_CHECK(output.data() >= hashFieldsData.data() &&
+                output.data() + output.size() <= hashFieldsData.data() + hashFieldsData.size());
+    // the output is encoded the same as the created receipt
+    BOOST_CHECK(decodedReceipt->hash() == receipt->hash());
+    auto reencodedReceipt = factory->createReceipt(decodedReceipt->encode(false).toBytes());
+    BOOST_CHECK(reencodedReceipt->output().toBytes() == receipt->output().toBytes());
+}
+
+BOOST_AUTO_TEST_CASE(testPooledReceiptOutput)
+{
+    auto hashImpl = std::make_shared<Keccak256Hash>();
+    auto cryptoSuite = std::make_shared<CryptoSuite>(hashImpl, nullptr, nullptr);
+    auto factory = std::make_shared<PBTransactionReceiptFactory>(cryptoSuite, 1);
+
+    // the receipts with the different outputs
+    std::vector<bytes> outputs = {bytes(), asBytes("output"), bytes(1024, 0xff), asBytes("o")};
+    std::vector<bytes> encodedReceipts;
+    for (auto const& output : outputs)
+    {
+        auto receipt = factory->createReceipt(
+            100, std::string_view(), fakeLogEntries(hashImpl, 2), 0, output, 10);
+        encodedReceipts.emplace_back(receipt->encode(false).toBytes());
+        BOOST_CHECK(receipt->output().toBytes() == output);
+    }
+    // decode => reset => reuse the same pooled receipt
+    for (size_t i = 0; i < encodedReceipts.size(); i++)
+    {
+        auto decodedReceipt = factory->createReceipt(encodedReceipts[i]);
+        BOOST_CHECK(decodedReceipt->output().toBytes() == outputs[i]);
+        BOOST_CHECK(decodedReceipt->encode(false).toBytes() == encodedReceipts[i]);
+    }
+    BOOST_CHECK_EQUAL(factory->pool()->allocatedCount(), 1);
+    BOOST_CHECK_EQUAL(factory->pool()->reusedCount(), encodedReceipts.size() - 1);
+
+    // re-decode the held receipt
+    auto decodedReceipt = factory->createReceipt(encodedReceipts[2]);
+    decodedReceipt->decode(ref(encodedReceipts[1]));
+    BOOST_CHECK(decodedReceipt->output().toBytes() == outputs[1]);
+}
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace bcos
\ No newline at end of file
@@ -19,10 +19,13 @@
  * @date: 2021-03-16
  */
 #include "libprotocol/protobuf/PBTransaction.h"
+#include "libprotocol/protobuf/PBTransactionFactory.h"
 #include "../../../testutils/TestPromptFixture.h"
 #include "libprotocol/Common.h"
+#include "libprotocol/TransactionSenderCache.h"
 #include "libutilities/DataConvertUtility.h"
 #include "testutils/protocol/FakeTransaction.h"
+#include "testutils/protocol/FakeTransactionReceipt.h"
 #include <boost/test/tools/old/interface.hpp>
 
 using namespace bcos;
@@ -168,6 +171,192 @@ BOOST_AUTO_TEST_CASE(testSMTransactionWithRawData)
         std::make_shared<PBTransaction>(cryptoSuite, *encodedBytes, true), PBObjectDecodeException);
         */
 }
+BOOST_AUTO_TEST_CASE(testTransactionSenderCache)
+{
+    auto hashImpl = std::make_shared<Keccak256Hash>();
+    auto signatureImpl = std::make_shared<Secp256k1SignatureImpl>();
+    auto cryptoSuite = std::make_shared<CryptoSuite>(hashImpl, signatureImpl, nullptr);
+
+    // the sender is bound to the signature
+    TransactionSenderCache cache(128);
+    auto txHash = hashImpl->hash(std::string("tx"));
+    bytes signature = asBytes("signature");
+    bytes sender = asBytes("sender");
+    bytes cachedSender;
+    BOOST_CHECK(!cache.get(txHash, ref(signature), cachedSender));
+    cache.insert(txHash, ref(signature), sender);
+    BOOST_CHECK(cache.get(txHash, ref(signature), cachedSender));
+    BOOST_CHECK(cachedSender == sender);
+    bytes fakeSignature = asBytes("fakeSignature");
+    BOOST_CHECK(!cache.get(txHash, ref(fakeSignature), cachedSender));
+    cache.erase(txHash);
+    BOOST_CHECK(!cache.get(txHash, ref(signature), cachedSender));
+
+    // the cache is bounded
+    for (int i = 0; i < 1000; i++)
+    {
+        cache.insert(hashImpl->hash(std::to_string(i)), ref(signature), sender);
+    }
+    BOOST_CHECK(cache.size() <= cache.capacity());
+    cache.clear();
+    BOOST_CHECK(cache.size() == 0);
+
+    // the erased and re-inserted sender is evicted in the order of the re-insertion
+    // 64 buckets with the capacity 128, every bucket holds 2 senders
+    std::vector<HashType> bucketHashes;
+    for (int i = 0; bucketHashes.size() < 3; i++)
+    {
+        auto hash = hashImpl->hash(std::to_string(i));
+        if (std::hash<HashType>()(hash) % 64 == 0)
+        {
+            bucketHashes.emplace_back(hash);
+        }
+    }
+    cache.insert(bucketHashes[0], ref(signature), sender);
+    cache.erase(bucketHashes[0]);
+    cache.insert(bucketHashes[1], ref(signature), sender);
+    cache.insert(bucketHashes[0], ref(signature), sender);
+    cache.insert(bucketHashes[2], ref(signature), sender);
+    BOOST_CHECK(cache.get(bucketHashes[0], ref(signature), cachedSender));
+    BOOST_CHECK(!cache.get(bucketHashes[1], ref(signature), cachedSender));
+    BOOST_CHECK(cache.get(bucketHashes[2], ref(signature), cachedSender));
+    cache.clear();
+    // disable the cache
+    cache.setCapacity(0);
+    cache.insert(txHash, ref(signature), sender);
+    BOOST_CHECK(cache.size() == 0);
+
+    // the decoded transaction hit the sender recovered before
+    auto tx = fakeTransaction(cryptoSuite);
+    auto encodedData = tx->encode(false);
+    auto& senderCache = TransactionSenderCache::instance();
+    BOOST_CHECK(senderCache.get(tx->hash(), tx->signatureData(), cachedSender));
+    BOOST_CHECK(std::string_view((char*)cachedSender.data(), cachedSender.size()) == tx->sender());
+
+    auto fakeSender = asBytes("fakeSender");
+    senderCache.insert(tx->hash(), tx->signatureData(), fakeSender);
+    auto decodedTx = std::make_shared<PBTransaction>(cryptoSuite, encodedData, true);
+    BOOST_CHECK(
+        decodedTx->sender() == std::string_view((char*)fakeSender.data(), fakeSender.size()));
+
+    senderCache.erase(tx->hash());
+    decodedTx = std::make_shared<PBTransaction>(cryptoSuite, encodedData, true);
+    BOOST_CHECK(decodedTx->sender() == tx->sender());
+}
+BOOST_AUTO_TEST_CASE(testPooledTransactionFactory)
+{
+    auto hashImpl = std::make_shared<Keccak256Hash>();
+    auto signatureImpl = std::make_shared<Secp256k1SignatureImpl>();
+    auto cryptoSuite = std::make_shared<CryptoSuite>(hashImpl, signatureImpl, nullptr);
+    // the pool is enabled by default
+    BOOST_CHECK(std::make_shared<PBTransactionFactory>(cryptoSuite)->pool());
+    BOOST_CHECK(!std::make_shared<PBTransactionFactory>(cryptoSuite, 0)->pool());
+    auto factory = std::make_shared<PBTransactionFactory>(cryptoSuite, 2);
+    auto pool = factory->pool();
+
+    std::vector<bytes> encodedTxs;
+    std::vector<Transaction::Ptr> txs;
+    for (size_t i = 0; i < 3; i++)
+    {
+        txs.emplace_back(fakeTransaction(cryptoSuite, utcTime() + i));
+        encodedTxs.emplace_back(txs.back()->encode(false).toBytes());
+    }
+    // decode the transactions, and release them into the pool
+    std::vector<Transaction::Ptr> decodedTxs;
+    for (size_t i = 0; i < 3; i++)
+    {
+        decodedTxs.emplace_back(factory->createTransaction(encodedTxs[i], true));
+        BOOST_CHECK_EQUAL(decodedTxs[i]->hash(), txs[i]->hash());
+    }
+    BOOST_CHECK_EQUAL(pool->allocatedCount(), 3);
+    BOOST_CHECK_EQUAL(pool->reusedCount(), 0);
+    BOOST_CHECK_EQUAL(pool->controlBlockAllocatedCount(), 3);
+    decodedTxs.clear();
+
+    // the transactions are reused, and the fields are overwritten
+    for (size_t i = 0; i < 3; i++)
+    {
+        auto decodedTx = factory->createTransaction(encodedTxs[2 - i], true);
+        checkTransaction(txs[2 - i], decodedTx);
+        BOOST_CHECK(decodedTx->sender() == txs[2 - i]->sender());
+        decodedTxs.emplace_back(decodedTx);
+    }
+    // only two transactions and two control blocks are kept in the pool
+    BOOST_CHECK_EQUAL(pool->allocatedCount(), 4);
+    BOOST_CHECK_EQUAL(pool->reusedCount(), 2);
+    BOOST_CHECK_EQUAL(pool->controlBlockAllocatedCount(), 4);
+    decodedTxs.clear();
+
+    // the states of the released transaction are cleared
+    auto node = signatureImpl->generateKeyPair()->publicKey();
+    auto callbackHolder = std::make_shared<int>(0);
+    auto tx = factory->createTransaction(encodedTxs[0], true);
+    tx->setSubmitCallback([callbackHolder](Error::Ptr, TransactionSubmitResult::Ptr) {});
+    tx->appendKnownNode(node);
+    tx->setSynced(true);
+    tx->setSealed(true);
+    tx->setInvalid(true);
+    tx->setSystemTx(true);
+    tx->setBatchId(100);
+    tx->setBatchHash(txs[0]->hash());
+    auto reusedCount = pool->reusedCount();
+    tx.reset();
+    BOOST_CHECK_EQUAL(callbackHolder.use_count(), 1);
+
+    tx = factory->createTransaction(encodedTxs[1], false);
+    BOOST_CHECK_EQUAL(pool->reusedCount(), reusedCount + 1);
+    BOOST_CHECK(tx->sender().empty());
+    BOOST_CHECK(!tx->submitCallback());
+    BOOST_CHECK(!tx->isKnownBy(node));
+    BOOST_CHECK(!tx->synced());
+    BOOST_CHECK(!tx->sealed());
+    BOOST_CHECK(!tx->invalid());
+    BOOST_CHECK(!tx->systemTx());
+    BOOST_CHECK_EQUAL(tx->batchId(), -1);
+    BOOST_CHECK(tx->batchHash() == HashType());
+    // the control blocks are recycled with the transactions
+    BOOST_CHECK_EQUAL(pool->controlBlockAllocatedCount(), 4);
+    decodedTxs.emplace_back(tx);
+
+    // the transaction released after the factory is destroyed
+    factory.reset();
+    pool.reset();
+    decodedTxs.clear();
+}
+
+BOOST_AUTO_TEST_CASE(testTransactionCryptoSuiteRetained)
+{
+    auto hashImpl = std::make_shared<Keccak256Hash>();
+    auto signatureImpl = std::make_shared<Secp256k1SignatureImpl>();
+    auto cryptoSuite = std::make_shared<CryptoSuite>(hashImpl, signatureImpl, nullptr);
+    auto factory = std::make_shared<PBTransactionFactory>(cryptoSuite);
+    auto encodedTx = fakeTransaction(cryptoSuite, utcTime())->encode(false).toBytes();
+
+    // the suite is retained once, the decoded transactions never copy the shared pointer
+    auto useCount = cryptoSuite.use_count();
+    std::vector<Transaction::Ptr> decodedTxs;
+    for (size_t i = 0; i < 10; i++)
+    {
+        decodedTxs.emplace_back(factory->createTransaction(encodedTx, false));
+    }
+    BOOST_CHECK_EQUAL(cryptoSuite.use_count(), useCount);
+    auto receipt = testPBTransactionReceipt(cryptoSuite);
+    BOOST_CHECK_EQUAL(cryptoSuite.use_count(), useCount);
+
+    // the transactions and the receipts stay usable after the factory and the creator released
+    // the suite
+    std::weak_ptr<CryptoSuite> weakCryptoSuite = cryptoSuite;
+    factory.reset();
+    cryptoSuite.reset();
+    BOOST_CHECK(!weakCryptoSuite.expired());
+    BOOST_CHECK(decodedTxs[0]->cryptoSuite() == weakCryptoSuite.lock());
+    BOOST_CHECK(receipt->cryptoSuite() == weakCryptoSuite.lock());
+    BOOST_CHECK_NO_THROW(decodedTxs[0]->verify());
+    BOOST_CHECK(!decodedTxs[0]->sender().empty());
+    decodedTxs.clear();
+    receipt.reset();
+    BOOST_CHECK(!weakCryptoSuite.expired());
+}
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace bcos
\ No newline at end of file
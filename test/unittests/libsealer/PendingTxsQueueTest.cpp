@@ -0,0 +1,169 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for PendingTxsQueue
+ * @file PendingTxsQueueTest.cpp
+ */
+#include "libsealer/PendingTxsQueue.h"
+#include "testutils/TestPromptFixture.h"
+#include "testutils/protocol/FakeBlock.h"
+#include <boost/test/unit_test.hpp>
+#include <thread>
+
+using namespace bcos;
+using namespace bcos::sealer;
+using namespace bcos::protocol;
+using namespace bcos::crypto;
+
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(PendingTxsQueueTest, TestPromptFixture)
+
+// the fetched block with the txs [_begin, _begin + _size)
+Block::Ptr fakeFetchedTxs(BlockFactory::Ptr _blockFactory, size_t _begin, size_t _size)
+{
+    auto block = _blockFactory->createBlock();
+    for (auto i = _begin; i < _begin + _size; i++)
+    {
+        block->appendTransactionMetaData(
+            _blockFactory->createTransactionMetaData(HashType(i), "to"));
+    }
+    return block;
+}
+
+// the hashes of the txs moved into the block
+HashList txsHash(Block::Ptr _block)
+{
+    HashList hashList;
+    for (size_t i = 0; i < _block->transactionsMetaDataSize(); i++)
+    {
+        hashList.emplace_back(_block->transactionMetaData(i)->hash());
+    }
+    return hashList;
+}
+
+HashList expectedTxsHash(size_t _begin, size_t _size)
+{
+    HashList hashList;
+    for (auto i = _begin; i < _begin + _size; i++)
+    {
+        hashList.emplace_back(HashType(i));
+    }
+    return hashList;
+}
+
+BOOST_AUTO_TEST_CASE(testPopInOrder)
+{
+    auto blockFactory = createBlockFactory(createNormalCryptoSuite());
+    auto queue = std::make_shared<PendingTxsQueue>();
+    // the empty chunk is ignored
+    queue->append(fakeFetchedTxs(blockFactory, 0, 0));
+    queue->append(fakeFetchedTxs(blockFactory, 0, 3));
+    queue->append(fakeFetchedTxs(blockFactory, 3, 5));
+    BOOST_CHECK_EQUAL(queue->size(), 8);
+
+    // across the chunk boundary, the second chunk is partially taken
+    auto block = blockFactory->createBlock();
+    BOOST_CHECK_EQUAL(queue->popTo(block, 4), 4);
+    BOOST_CHECK(txsHash(block) == expectedTxsHash(0, 4));
+    BOOST_CHECK_EQUAL(queue->size(), 4);
+
+    // the chunk appended after the swap is taken after the remaining txs
+    queue->append(fakeFetchedTxs(blockFactory, 8, 2));
+    BOOST_CHECK_EQUAL(queue->size(), 6);
+    block = blockFactory->createBlock();
+    BOOST_CHECK_EQUAL(queue->popTo(block, 2), 2);
+    BOOST_CHECK(txsHash(block) == expectedTxsHash(4, 2));
+    block = blockFactory->createBlock();
+    BOOST_CHECK_EQUAL(queue->popTo(block, 100), 4);
+    BOOST_CHECK(txsHash(block) == expectedTxsHash(6, 4));
+    BOOST_CHECK_EQUAL(queue->size(), 0);
+
+    block = blockFactory->createBlock();
+    BOOST_CHECK_EQUAL(queue->popTo(block, 100), 0);
+    BOOST_CHECK_EQUAL(block->transactionsMetaDataSize(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(testClear)
+{
+    auto blockFactory = createBlockFactory(createNormalCryptoSuite());
+    auto queue = std::make_shared<PendingTxsQueue>();
+    queue->append(fakeFetchedTxs(blockFactory, 0, 5));
+    queue->append(fakeFetchedTxs(blockFactory, 5, 5));
+    // the first chunk is swapped into the output buffer with an offset
+    auto block = blockFactory->createBlock();
+    BOOST_CHECK_EQUAL(queue->popTo(block, 3), 3);
+    // the chunk still in the input buffer
+    queue->append(fakeFetchedTxs(blockFactory, 10, 2));
+
+    // only the txs not taken are returned, in order
+    auto clearedTxs = queue->clear();
+    BOOST_CHECK(*clearedTxs == expectedTxsHash(3, 9));
+    BOOST_CHECK_EQUAL(queue->size(), 0);
+    BOOST_CHECK(queue->clear()->empty());
+
+    // the queue is reusable after clear
+    queue->append(fakeFetchedTxs(blockFactory, 20, 2));
+    block = blockFactory->createBlock();
+    BOOST_CHECK_EQUAL(queue->popTo(block, 10), 2);
+    BOOST_CHECK(txsHash(block) == expectedTxsHash(20, 2));
+}
+
+BOOST_AUTO_TEST_CASE(testConcurrentAppendAndPop)
+{
+    auto blockFactory = createBlockFactory(createNormalCryptoSuite());
+    auto queue = std::make_shared<PendingTxsQueue>();
+    size_t chunksSize = 200;
+    size_t chunkSize = 7;
+    std::vector<Block::Ptr> chunks;
+    for (size_t i = 0; i < chunksSize; i++)
+    {
+        chunks.emplace_back(fakeFetchedTxs(blockFactory, i * chunkSize, chunkSize));
+    }
+    std::atomic<bool> appended = {false};
+    std::thread fetcher([&]() {
+        for (auto const& chunk : chunks)
+        {
+            queue->append(chunk);
+        }
+        appended = true;
+    });
+
+    HashList poppedTxs;
+    size_t totalTxsSize = chunksSize * chunkSize;
+    while (poppedTxs.size() < totalTxsSize)
+    {
+        auto allAppended = appended.load();
+        auto block = blockFactory->createBlock();
+        auto poppedSize = queue->popTo(block, 5);
+        // the size counts the appended txs before they are visible to popTo, so it never
+        // underflows and never exceeds the txs not popped
+        BOOST_CHECK_LE(queue->size(), totalTxsSize - poppedTxs.size() - poppedSize);
+        auto hashList = txsHash(block);
+        poppedTxs.insert(poppedTxs.end(), hashList.begin(), hashList.end());
+        if (poppedSize == 0 && allAppended)
+        {
+            break;
+        }
+    }
+    fetcher.join();
+    BOOST_CHECK(poppedTxs == expectedTxsHash(0, totalTxsSize));
+    BOOST_CHECK_EQUAL(queue->size(), 0);
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
@@ -0,0 +1,254 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the Sealer and the SealingManager
+ * @file SealerTest.cpp
+ */
+#include "interfaces/consensus/ConsensusNode.h"
+#include "libsealer/Sealer.h"
+#include "testutils/TestPromptFixture.h"
+#include "testutils/faker/FakeConsensus.h"
+#include "testutils/faker/FakeTxPool.h"
+#include "testutils/protocol/FakeBlock.h"
+#include <boost/test/unit_test.hpp>
+#include <thread>
+
+using namespace bcos;
+using namespace bcos::sealer;
+using namespace bcos::protocol;
+using namespace bcos::crypto;
+
+namespace bcos
+{
+namespace test
+{
+class FakeSealerImpl : public Sealer
+{
+public:
+    using Ptr = std::shared_ptr<FakeSealerImpl>;
+    explicit FakeSealerImpl(SealerConfig::Ptr _sealerConfig) : Sealer(_sealerConfig) {}
+
+    SealingManager::Ptr sealingManager() { return m_sealingManager; }
+    using Sealer::submitProposal;
+    void encodeAndSubmitProposal(bool _containSysTxs, Block::Ptr _proposal) override
+    {
+        // keep the submit worker busy
+        std::this_thread::sleep_for(std::chrono::milliseconds(m_submitDelay));
+        Sealer::encodeAndSubmitProposal(_containSysTxs, _proposal);
+    }
+    void waitSealingEvent() override { Sealer::waitSealingEvent(); }
+    void noteGenerateProposal() override
+    {
+        // the woken sealer checks whether the transactions can be fetched
+        m_fetchableOnNote = m_sealingManager->shouldFetchTransaction();
+        m_notedCount++;
+        Sealer::noteGenerateProposal();
+    }
+
+    std::atomic<size_t> m_notedCount = {0};
+    std::atomic_bool m_fetchableOnNote = {false};
+    std::atomic<uint64_t> m_submitDelay = {0};
+};
+
+class SealerFixture : public TestPromptFixture
+{
+public:
+    SealerFixture()
+    {
+        blockFactory = createBlockFactory(createNormalCryptoSuite());
+        txpool = std::make_shared<FakeTxPool>();
+        consensus = std::make_shared<FakeConsensus>();
+        sealerConfig = std::make_shared<SealerConfig>(blockFactory, txpool);
+        sealerConfig->setConsensusInterface(consensus);
+        sealer = std::make_shared<FakeSealerImpl>(sealerConfig);
+    }
+
+    Block::Ptr fakeProposal(BlockNumber _number, size_t _begin, size_t _size)
+    {
+        auto proposal = fakeSealedTxs(_begin, _size);
+        auto blockHeader = blockFactory->blockHeaderFactory()->createBlockHeader();
+        blockHeader->setNumber(_number);
+        proposal->setBlockHeader(blockHeader);
+        return proposal;
+    }
+
+    Block::Ptr fakeSealedTxs(size_t _begin, size_t _size)
+    {
+        auto block = blockFactory->createBlock();
+        for (auto i = _begin; i < _begin + _size; i++)
+        {
+            block->appendTransactionMetaData(
+                blockFactory->createTransactionMetaData(HashType(i), "to"));
+        }
+        return block;
+    }
+
+    BlockFactory::Ptr blockFactory;
+    FakeTxPool::Ptr txpool;
+    FakeConsensus::Ptr consensus;
+    SealerConfig::Ptr sealerConfig;
+    FakeSealerImpl::Ptr sealer;
+};
+
+BOOST_FIXTURE_TEST_SUITE(SealerTest, SealerFixture)
+
+BOOST_AUTO_TEST_CASE(testFetchWakesUpSealer)
+{
+    auto sealingManager = sealer->sealingManager();
+    sealingManager->resetSealingInfo(2, 2, 10);
+    sealingManager->setUnsealedTxsSize(5);
+    BOOST_CHECK_EQUAL(consensus->unsealedTxsSize(), 5);
+    BOOST_CHECK(sealingManager->shouldFetchTransaction());
+
+    // the sealer is woken up after the fetching finished, so it can fetch again
+    txpool->setSealedTxs(fakeSealedTxs(0, 3), fakeSealedTxs(0, 0));
+    sealingManager->fetchTransactions();
+    BOOST_CHECK_EQUAL(sealer->m_notedCount, 1);
+    BOOST_CHECK(sealer->m_fetchableOnNote);
+
+    // the empty fetching
+    sealer->m_fetchableOnNote = false;
+    txpool->setSealedTxs(fakeSealedTxs(0, 0), fakeSealedTxs(0, 0));
+    sealingManager->fetchTransactions();
+    BOOST_CHECK_EQUAL(sealer->m_notedCount, 2);
+    BOOST_CHECK(sealer->m_fetchableOnNote);
+
+    // the failed fetching
+    sealer->m_fetchableOnNote = false;
+    txpool->setSealTxsError(std::make_shared<Error>(-1, "fetch failed"));
+    sealingManager->fetchTransactions();
+    BOOST_CHECK_EQUAL(sealer->m_notedCount, 3);
+    BOOST_CHECK(sealer->m_fetchableOnNote);
+}
+
+BOOST_AUTO_TEST_CASE(testWaitSealingEvent)
+{
+    // the event noted before the wait is not missed
+    sealer->noteGenerateProposal();
+    auto startT = utcSteadyTime();
+    sealer->waitSealingEvent();
+    BOOST_CHECK_LT(utcSteadyTime() - startT, 50);
+
+    // the event is consumed, wait until the max wait time
+    startT = utcSteadyTime();
+    sealer->waitSealingEvent();
+    BOOST_CHECK_GE(utcSteadyTime() - startT, 90);
+
+    // the event noted during the wait
+    startT = utcSteadyTime();
+    std::thread noter([this]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        sealer->noteGenerateProposal();
+    });
+    sealer->waitSealingEvent();
+    noter.join();
+    BOOST_CHECK_LT(utcSteadyTime() - startT, 90);
+}
+BOOST_AUTO_TEST_CASE(testSubmitProposal)
+{
+    auto cryptoSuite = blockFactory->cryptoSuite();
+    ConsensusNodeList consensusNodeList;
+    for (uint64_t weight = 1; weight <= 4; weight++)
+    {
+        auto nodeID = cryptoSuite->signatureImpl()->generateKeyPair()->publicKey();
+        consensusNodeList.emplace_back(std::make_shared<ConsensusNode>(nodeID, weight));
+    }
+    consensus->setConsensusNodeList(consensusNodeList);
+
+    sealer->start();
+    std::vector<Block::Ptr> proposals;
+    for (BlockNumber number = 1; number <= 3; number++)
+    {
+        proposals.emplace_back(fakeProposal(number, number * 10, 2));
+        sealer->submitProposal(false, proposals.back());
+    }
+    while (consensus->submittedProposals().size() < proposals.size())
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    // the proposals are submitted in order with the sealer list and the weight list
+    BOOST_CHECK(consensus->submittedProposals() == std::vector<BlockNumber>({1, 2, 3}));
+    for (auto const& proposal : proposals)
+    {
+        auto sealerList = proposal->blockHeader()->sealerList();
+        auto weightList = proposal->blockHeader()->consensusWeights();
+        BOOST_CHECK_EQUAL(sealerList.size(), consensusNodeList.size());
+        BOOST_CHECK_EQUAL(weightList.size(), consensusNodeList.size());
+        for (size_t i = 0; i < consensusNodeList.size(); i++)
+        {
+            BOOST_CHECK(sealerList[i] == consensusNodeList[i]->nodeID()->data());
+            BOOST_CHECK_EQUAL(weightList[i], consensusNodeList[i]->weight());
+        }
+    }
+    BOOST_CHECK(txpool->unsealedTxs().empty());
+    sealer->stop();
+}
+
+BOOST_AUTO_TEST_CASE(testRestart)
+{
+    sealer->start();
+    sealer->submitProposal(false, fakeProposal(1, 10, 2));
+    sealer->stop();
+    auto submittedSize = consensus->submittedProposals().size();
+
+    // the proposals are submitted after the sealer restarted
+    sealer->start();
+    for (BlockNumber number = 2; number <= 3; number++)
+    {
+        sealer->submitProposal(false, fakeProposal(number, number * 10, 2));
+    }
+    auto startT = utcSteadyTime();
+    while (consensus->submittedProposals().size() < submittedSize + 2 &&
+           utcSteadyTime() - startT < 5000)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    auto submittedProposals = consensus->submittedProposals();
+    BOOST_CHECK_EQUAL(submittedProposals.size(), submittedSize + 2);
+    BOOST_CHECK(std::vector<BlockNumber>(submittedProposals.end() - 2,
+                    submittedProposals.end()) == std::vector<BlockNumber>({2, 3}));
+    sealer->stop();
+}
+
+BOOST_AUTO_TEST_CASE(testStopResetsPendingProposals)
+{
+    sealer->start();
+    sealer->m_submitDelay = 200;
+    std::vector<Block::Ptr> proposals;
+    for (BlockNumber number = 1; number <= 3; number++)
+    {
+        proposals.emplace_back(fakeProposal(number, number * 10, 2));
+        sealer->submitProposal(false, proposals.back());
+    }
+    sealer->stop();
+
+    // the proposals not submitted are returned back to the txpool
+    auto submittedProposals = consensus->submittedProposals();
+    BOOST_CHECK_GE(submittedProposals.size(), 1);
+    BOOST_CHECK_LT(submittedProposals.size(), proposals.size());
+    HashList expectedTxs;
+    for (auto i = submittedProposals.size(); i < proposals.size(); i++)
+    {
+        BOOST_CHECK_EQUAL(proposals[i]->blockHeader()->number(), i + 1);
+        for (size_t j = 0; j < proposals[i]->transactionsHashSize(); j++)
+        {
+            expectedTxs.emplace_back(proposals[i]->transactionHash(j));
+        }
+    }
+    BOOST_CHECK(txpool->unsealedTxs() == expectedTxs);
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
@@ -0,0 +1,160 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for SealingController
+ * @file SealingControllerTest.cpp
+ */
+#include "libsealer/SealingController.h"
+#include "testutils/TestPromptFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <thread>
+
+using namespace bcos;
+using namespace bcos::sealer;
+
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(SealingControllerTest, TestPromptFixture)
+
+// the arrival rate is sampled at most once per 100ms
+void sleepForSampling()
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+}
+
+// sample the arrival rate with _txsSize txs arrived
+void noteArrivedTxs(SealingController::Ptr _controller, size_t _txsSize)
+{
+    _controller->onUnsealedTxsSize(0);
+    sleepForSampling();
+    _controller->onUnsealedTxsSize(_txsSize);
+}
+
+// sample the round time with _rounds blocks committed in about _roundTime * _rounds ms
+void noteCommittedBlocks(SealingController::Ptr _controller, int64_t _rounds, uint64_t _roundTime)
+{
+    _controller->onBlockCommitted(1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(_roundTime * _rounds));
+    _controller->onBlockCommitted(1 + _rounds);
+}
+
+BOOST_AUTO_TEST_CASE(testFixedSealing)
+{
+    auto config = std::make_shared<SealerConfig>(nullptr, nullptr);
+    auto controller = std::make_shared<SealingController>(config);
+    noteArrivedTxs(controller, 1000);
+    noteCommittedBlocks(controller, 1, 100);
+    BOOST_CHECK_GT(controller->metrics().arrivalRate, 0);
+    BOOST_CHECK_GT(controller->metrics().roundTime, 0);
+
+    // the observations are ignored if the adaptive sealing is off
+    BOOST_CHECK_EQUAL(controller->targetTxsPerBlock(1000), 1000);
+    BOOST_CHECK_EQUAL(controller->sealTime(0, 1000), config->minSealTime());
+    BOOST_CHECK_EQUAL(controller->sealTime(2000, 1000), config->minSealTime());
+    BOOST_CHECK_EQUAL(controller->metrics().sealTime, config->minSealTime());
+    BOOST_CHECK_EQUAL(controller->metrics().targetTxsPerBlock, 1000);
+}
+
+BOOST_AUTO_TEST_CASE(testArrivalRateSampling)
+{
+    auto config = std::make_shared<SealerConfig>(nullptr, nullptr);
+    auto controller = std::make_shared<SealingController>(config);
+    controller->onUnsealedTxsSize(0);
+    // the note within the sample interval is ignored
+    controller->onUnsealedTxsSize(100);
+    BOOST_CHECK_EQUAL(controller->metrics().arrivalRate, 0);
+
+    // the fetched txs are counted as arrived
+    sleepForSampling();
+    controller->onTxsFetched(100);
+    controller->onUnsealedTxsSize(200);
+    auto arrivalRate = controller->metrics().arrivalRate;
+    // 300 txs arrived in at least 150ms
+    BOOST_CHECK_GT(arrivalRate, 0);
+    BOOST_CHECK_LE(arrivalRate, 2);
+
+    // no txs arrived, the rate decays by the weight of the newest sample
+    sleepForSampling();
+    controller->onTxsFetched(50);
+    controller->onUnsealedTxsSize(100);
+    BOOST_CHECK_CLOSE(controller->metrics().arrivalRate, arrivalRate * 0.8, 0.001);
+}
+
+BOOST_AUTO_TEST_CASE(testBoundsClamp)
+{
+    auto config = std::make_shared<SealerConfig>(nullptr, nullptr);
+    config->setAdaptiveSealing(true);
+    auto controller = std::make_shared<SealingController>(config);
+    // no observations
+    BOOST_CHECK_EQUAL(controller->targetTxsPerBlock(1000), 1000);
+    BOOST_CHECK_EQUAL(controller->sealTime(0, 1000), config->minSealTime());
+
+    // about 100 txs arrive in a round
+    noteArrivedTxs(controller, 150);
+    noteCommittedBlocks(controller, 1, 100);
+    auto metrics = controller->metrics();
+    auto expectedTarget = (size_t)(metrics.arrivalRate * metrics.roundTime);
+    BOOST_CHECK_GT(expectedTarget, 1);
+    BOOST_CHECK_LT(expectedTarget, 1000);
+    BOOST_CHECK_EQUAL(controller->targetTxsPerBlock(1000), expectedTarget);
+
+    // bounded by the max txs per block and the min txs per block
+    BOOST_CHECK_EQUAL(controller->targetTxsPerBlock(1), 1);
+    config->setMinTxsPerBlock(500);
+    BOOST_CHECK_EQUAL(controller->targetTxsPerBlock(1000), 500);
+    BOOST_CHECK_EQUAL(controller->targetTxsPerBlock(200), 200);
+    config->setMinTxsPerBlock(1);
+
+    // seal at once if the block is filled
+    auto sealTime = controller->sealTime(expectedTarget, 1000);
+    BOOST_CHECK_EQUAL(sealTime, config->minSealTimeLowerBound());
+    BOOST_CHECK_EQUAL(controller->metrics().sealTime, sealTime);
+    BOOST_CHECK_EQUAL(controller->metrics().targetTxsPerBlock, expectedTarget);
+    // wait for the block to be filled, bounded by the min seal time and its lower bound
+    sealTime = controller->sealTime(0, 1000);
+    BOOST_CHECK_GE(sealTime, config->minSealTimeLowerBound());
+    BOOST_CHECK_LE(sealTime, config->minSealTime());
+    BOOST_CHECK_EQUAL(sealTime,
+        std::max((uint64_t)config->minSealTimeLowerBound(),
+            std::min((uint64_t)config->minSealTime(),
+                (uint64_t)(expectedTarget / metrics.arrivalRate))));
+    // the lower bound never exceeds the min seal time
+    config->setMinSealTimeLowerBound(config->minSealTime() + 100);
+    BOOST_CHECK_EQUAL(controller->sealTime(expectedTarget, 1000), config->minSealTime());
+}
+
+BOOST_AUTO_TEST_CASE(testCommitLatency)
+{
+    auto config = std::make_shared<SealerConfig>(nullptr, nullptr);
+    config->setAdaptiveSealing(true);
+    auto controller = std::make_shared<SealingController>(config);
+    noteArrivedTxs(controller, 10000);
+    // the block sealed before the 9 rounds is committed at the end
+    controller->onProposalSealed(10);
+    noteCommittedBlocks(controller, 9, 30);
+    auto metrics = controller->metrics();
+    BOOST_CHECK_GT(metrics.commitLatency, 2 * metrics.roundTime);
+
+    // the block is shrunk as the commit lags more than two rounds
+    auto roundTarget = metrics.arrivalRate * metrics.roundTime;
+    auto expectedTarget = (size_t)(roundTarget * (2 * metrics.roundTime) / metrics.commitLatency);
+    BOOST_CHECK_LT(expectedTarget, (size_t)roundTarget);
+    BOOST_CHECK_EQUAL(controller->targetTxsPerBlock(100000), expectedTarget);
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
@@ -0,0 +1,98 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief benchmark for the base64 codec
+ * @file Base64Perf.cpp
+ */
+#include "../../../testutils/TestPromptFixture.h"
+#include "libutilities/Base64.h"
+#include <boost/archive/iterators/base64_from_binary.hpp>
+#include <boost/archive/iterators/binary_from_base64.hpp>
+#include <boost/archive/iterators/transform_width.hpp>
+#include <boost/test/unit_test.hpp>
+#include <random>
+
+using namespace bcos;
+using namespace boost::archive::iterators;
+
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(Base64Perf, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(base64CodecPerf)
+{
+    size_t const size = 16 * 1024 * 1024;
+    size_t const round = 3;
+    std::mt19937 random(size);
+    bytes data(size);
+    for (auto& value : data)
+    {
+        value = random() & 0xff;
+    }
+    auto megaBytesPerSecond = [](size_t _bytes, int64_t _us) {
+        return _us == 0 ? 0 : (double)_bytes / _us;
+    };
+
+    // the boost iterator pipeline, used as the baseline
+    using EncodeIt = base64_from_binary<transform_width<byte*, 6, 8>>;
+    std::string baselineEncoded;
+    auto startT = utcSteadyTimeUs();
+    for (size_t i = 0; i < round; i++)
+    {
+        baselineEncoded = std::string(EncodeIt(data.data()), EncodeIt(data.data() + size));
+        baselineEncoded.append((3 - size % 3) % 3, '=');
+    }
+    auto baselineEncodeCost = utcSteadyTimeUs() - startT;
+
+    std::string encoded;
+    startT = utcSteadyTimeUs();
+    for (size_t i = 0; i < round; i++)
+    {
+        encoded = base64Encode(data.data(), size);
+    }
+    auto encodeCost = utcSteadyTimeUs() - startT;
+    BOOST_CHECK(encoded == baselineEncoded);
+
+    using DecodeIt = transform_width<binary_from_base64<std::string::const_iterator>, 8, 6>;
+    std::string baselineDecoded;
+    startT = utcSteadyTimeUs();
+    for (size_t i = 0; i < round; i++)
+    {
+        baselineDecoded = std::string(DecodeIt(encoded.begin()), DecodeIt(encoded.end()));
+    }
+    auto baselineDecodeCost = utcSteadyTimeUs() - startT;
+
+    bytes decoded(base64DecodedMaxSize(encoded.size()));
+    size_t decodedSize = 0;
+    startT = utcSteadyTimeUs();
+    for (size_t i = 0; i < round; i++)
+    {
+        base64Decode(encoded.data(), encoded.size(), decoded.data(), decodedSize);
+    }
+    auto decodeCost = utcSteadyTimeUs() - startT;
+    BOOST_CHECK_EQUAL(decodedSize, size);
+    BOOST_CHECK(std::equal(data.begin(), data.end(), decoded.begin()));
+
+    std::cout << "#### base64, encode before(MB/s): "
+              << megaBytesPerSecond(size * round, baselineEncodeCost)
+              << ", after(MB/s): " << megaBytesPerSecond(size * round, encodeCost)
+              << ", decode before(MB/s): " << megaBytesPerSecond(size * round, baselineDecodeCost)
+              << ", after(MB/s): " << megaBytesPerSecond(size * round, decodeCost) << std::endl;
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
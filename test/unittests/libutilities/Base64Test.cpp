@@ -19,6 +19,7 @@
 #include "libutilities/Base64.h"
 #include "../../../testutils/TestPromptFixture.h"
 #include "libutilities/DataConvertUtility.h"
+#include "libutilities/Exceptions.h"
 #include <boost/test/unit_test.hpp>
 #include <iostream>
 #include <string>
@@ -93,6 +94,49 @@ BOOST_AUTO_TEST_CASE(testBase64CodecZero)
     BOOST_CHECK_EQUAL(ov.size(), 100);
 }
 
+BOOST_AUTO_TEST_CASE(testBase64Padding)
+{
+    // RFC 4648 test vectors
+    std::vector<std::pair<std::string, std::string>> vectors = {{"", ""}, {"f", "Zg=="},
+        {"fo", "Zm8="}, {"foo", "Zm9v"}, {"foob", "Zm9vYg=="}, {"fooba", "Zm9vYmE="},
+        {"foobar", "Zm9vYmFy"}};
+    for (auto const& it : vectors)
+    {
+        BOOST_CHECK_EQUAL(base64Encode(it.first), it.second);
+        BOOST_CHECK_EQUAL(base64Decode(it.second), it.first);
+        // the padding is optional
+        auto unpadded = it.second.substr(0, it.second.find('='));
+        BOOST_CHECK_EQUAL(base64Decode(unpadded), it.first);
+    }
+    std::string allBytes;
+    for (int i = 0; i < 256; i++)
+    {
+        allBytes.push_back((char)i);
+    }
+    BOOST_CHECK_EQUAL(base64Decode(base64Encode(allBytes)), allBytes);
+}
+
+BOOST_AUTO_TEST_CASE(testInvalidBase64)
+{
+    std::vector<std::string> invalidData = {"Zm9v!mFy", "Zm9vY", "Z", "Zm=v", "Zm9vY===",
+        "Zm9v\n", "====", "Zm9 vYmFy", std::string("Zm9v\0mFy", 8)};
+    for (auto const& invalid : invalidData)
+    {
+        bytes out(base64DecodedMaxSize(invalid.size()));
+        size_t decodedSize = 0;
+        BOOST_CHECK(!base64Decode(invalid.data(), invalid.size(), out.data(), decodedSize));
+        BOOST_CHECK_THROW(base64Decode(invalid), BadBase64Character);
+        BOOST_CHECK_THROW(base64DecodeBytes(invalid), BadBase64Character);
+    }
+    // the no-throw decoder into the caller buffer
+    std::string encoded = "Zm9vYmE=";
+    bytes out(base64DecodedMaxSize(encoded.size()));
+    size_t decodedSize = 0;
+    BOOST_CHECK(base64Decode(encoded.data(), encoded.size(), out.data(), decodedSize));
+    BOOST_CHECK_EQUAL(decodedSize, 5);
+    BOOST_CHECK_EQUAL(std::string((char*)out.data(), decodedSize), "fooba");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace bcos
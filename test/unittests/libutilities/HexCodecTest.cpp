@@ -0,0 +1,151 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief unit test and benchmark for the hex kernels
+ *
+ * @file HexCodecTest.cpp
+ */
+#include "libutilities/HexCodec.h"
+#include "libutilities/DataConvertUtility.h"
+#include "libutilities/Exceptions.h"
+#include "../../../testutils/TestPromptFixture.h"
+#include <boost/algorithm/hex.hpp>
+#include <boost/test/unit_test.hpp>
+#include <random>
+
+using namespace bcos;
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(HexCodecTest, TestPromptFixture)
+
+bytes randomBytes(size_t _size)
+{
+    std::mt19937 random(_size);
+    bytes data(_size);
+    for (auto& value : data)
+    {
+        value = random() & 0xff;
+    }
+    return data;
+}
+
+BOOST_AUTO_TEST_CASE(testHexKernels)
+{
+    std::cout << "#### hex kernel: " << hexCodecKernel() << std::endl;
+    // cover the vectorized blocks and the scalar tails
+    for (size_t size : {0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 1000})
+    {
+        auto data = randomBytes(size);
+        std::string expectedHex;
+        boost::algorithm::hex_lower(data.begin(), data.end(), std::back_inserter(expectedHex));
+
+        std::string hex(size * 2, 0);
+        encodeHex(data.data(), data.size(), hex.data());
+        BOOST_CHECK_EQUAL(hex, expectedHex);
+        BOOST_CHECK_EQUAL(*toHexString(data), expectedHex);
+        BOOST_CHECK_EQUAL(toHex(data), expectedHex);
+        BOOST_CHECK_EQUAL(toHexStringWithPrefix(data), "0x" + expectedHex);
+
+        bytes decodedData(size);
+        BOOST_CHECK(decodeHex(hex.data(), hex.size(), decodedData.data()));
+        BOOST_CHECK(decodedData == data);
+        BOOST_CHECK(*fromHexString("0x" + hex) == data);
+
+        // the upper case hex
+        std::string upperHex;
+        boost::algorithm::hex(data.begin(), data.end(), std::back_inserter(upperHex));
+        BOOST_CHECK(decodeHex(upperHex.data(), upperHex.size(), decodedData.data()));
+        BOOST_CHECK(decodedData == data);
+
+        // the non-hex char in every position
+        for (size_t i = 0; i < hex.size(); i += 7)
+        {
+            for (char invalidChar : {'g', 'G', '/', ':', '@', '`', ' ', '\xe1'})
+            {
+                auto invalidHex = hex;
+                invalidHex[i] = invalidChar;
+                BOOST_CHECK(!decodeHex(invalidHex.data(), invalidHex.size(), decodedData.data()));
+                BOOST_CHECK(
+                    !decodeHexScalar(invalidHex.data(), invalidHex.size(), decodedData.data()));
+            }
+            auto invalidHex = hex;
+            invalidHex[i] = 'x';
+            BOOST_CHECK_THROW(fromHexString(invalidHex), BadHexCharacter);
+            BOOST_CHECK_THROW(fromHex(invalidHex), bcos::Error);
+        }
+    }
+    // the odd hex string
+    BOOST_CHECK(*fromHexString("0x123") == bytes({0x01, 0x23}));
+    BOOST_CHECK_THROW(fromHex(std::string("123")), bcos::Error);
+    BOOST_CHECK(fromHex(std::string("0xAbcD"), "0x") == bytes({0xab, 0xcd}));
+}
+
+BOOST_AUTO_TEST_CASE(hexKernelsPerf)
+{
+    size_t const size = 16 * 1024 * 1024;
+    size_t const round = 5;
+    auto data = randomBytes(size);
+    auto megaBytesPerSecond = [](size_t _bytes, int64_t _us) {
+        return _us == 0 ? 0 : (double)_bytes / _us;
+    };
+
+    // the byte-at-a-time baseline
+    std::string baselineHex;
+    auto startT = utcSteadyTimeUs();
+    for (size_t i = 0; i < round; i++)
+    {
+        baselineHex.clear();
+        boost::algorithm::hex_lower(data.begin(), data.end(), std::back_inserter(baselineHex));
+    }
+    auto baselineEncodeCost = utcSteadyTimeUs() - startT;
+
+    std::string hex(size * 2, 0);
+    startT = utcSteadyTimeUs();
+    for (size_t i = 0; i < round; i++)
+    {
+        encodeHex(data.data(), data.size(), hex.data());
+    }
+    auto encodeCost = utcSteadyTimeUs() - startT;
+    BOOST_CHECK(hex == baselineHex);
+
+    bytes baselineData;
+    startT = utcSteadyTimeUs();
+    for (size_t i = 0; i < round; i++)
+    {
+        baselineData.clear();
+        boost::algorithm::unhex(hex.begin(), hex.end(), std::back_inserter(baselineData));
+    }
+    auto baselineDecodeCost = utcSteadyTimeUs() - startT;
+
+    bytes decodedData(size);
+    startT = utcSteadyTimeUs();
+    for (size_t i = 0; i < round; i++)
+    {
+        decodeHex(hex.data(), hex.size(), decodedData.data());
+    }
+    auto decodeCost = utcSteadyTimeUs() - startT;
+    BOOST_CHECK(decodedData == baselineData);
+
+    std::cout << "#### hex kernel: " << hexCodecKernel()
+              << ", encode before(MB/s): " << megaBytesPerSecond(size * round, baselineEncodeCost)
+              << ", after(MB/s): " << megaBytesPerSecond(size * round, encodeCost)
+              << ", decode before(MB/s): " << megaBytesPerSecond(size * round, baselineDecodeCost)
+              << ", after(MB/s): " << megaBytesPerSecond(size * round, decodeCost) << std::endl;
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
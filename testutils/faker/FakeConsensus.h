@@ -0,0 +1,99 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief fake consensus for the sealer
+ * @file FakeConsensus.h
+ */
+#pragma once
+#include "../../interfaces/consensus/ConsensusInterface.h"
+#include <atomic>
+
+using namespace bcos;
+using namespace bcos::consensus;
+using namespace bcos::protocol;
+
+namespace bcos
+{
+namespace test
+{
+class FakeConsensus : public ConsensusInterface
+{
+public:
+    using Ptr = std::shared_ptr<FakeConsensus>;
+    FakeConsensus() = default;
+    ~FakeConsensus() override {}
+
+    void start() override {}
+    void stop() override {}
+
+    // record the number of the submitted proposals
+    void asyncSubmitProposal(bool, bytesConstRef, BlockNumber _proposalIndex,
+        bcos::crypto::HashType const&, std::function<void(Error::Ptr)> _onProposalSubmitted) override
+    {
+        {
+            Guard l(x_submittedProposals);
+            m_submittedProposals.emplace_back(_proposalIndex);
+        }
+        if (_onProposalSubmitted)
+        {
+            _onProposalSubmitted(nullptr);
+        }
+    }
+    std::vector<BlockNumber> submittedProposals()
+    {
+        Guard l(x_submittedProposals);
+        return m_submittedProposals;
+    }
+
+    void asyncGetPBFTView(std::function<void(Error::Ptr, ViewType)>) override {}
+    void asyncCheckBlock(Block::Ptr, std::function<void(Error::Ptr, bool)>) override {}
+    void asyncNotifyNewBlock(
+        bcos::ledger::LedgerConfig::Ptr, std::function<void(Error::Ptr)>) override
+    {}
+    void asyncNotifyConsensusMessage(Error::Ptr, std::string const&, bcos::crypto::NodeIDPtr,
+        bytesConstRef, std::function<void(Error::Ptr)>) override
+    {}
+    void notifyHighestSyncingNumber(BlockNumber) override {}
+
+    void asyncNoteUnSealedTxsSize(
+        size_t _unsealedTxsSize, std::function<void(Error::Ptr)> _onRecvResponse) override
+    {
+        m_unsealedTxsSize = _unsealedTxsSize;
+        if (_onRecvResponse)
+        {
+            _onRecvResponse(nullptr);
+        }
+    }
+    size_t unsealedTxsSize() const { return m_unsealedTxsSize; }
+
+    ConsensusNodeList consensusNodeList() const override { return m_consensusNodeList; }
+    void setConsensusNodeList(ConsensusNodeList const& _consensusNodeList)
+    {
+        m_consensusNodeList = _consensusNodeList;
+    }
+
+    void asyncGetConsensusStatus(std::function<void(Error::Ptr, std::string)>) override {}
+    void notifyConnectedNodes(
+        bcos::crypto::NodeIDSet const&, std::function<void(Error::Ptr)>) override
+    {}
+
+private:
+    std::vector<BlockNumber> m_submittedProposals;
+    Mutex x_submittedProposals;
+    std::atomic<size_t> m_unsealedTxsSize = {0};
+    ConsensusNodeList m_consensusNodeList;
+};
+}  // namespace test
+}  // namespace bcos
@@ -70,15 +70,47 @@ public:
     void notifyConnectedNodes(
         bcos::crypto::NodeIDSet const&, std::function<void(Error::Ptr)>) override
     {}
+    // response the sealed txs set by setSealedTxs, or the error set by setSealTxsError
     void asyncSealTxs(size_t, TxsHashSetPtr,
-        std::function<void(Error::Ptr, bcos::protocol::Block::Ptr, bcos::protocol::Block::Ptr)>)
-        override
-    {}
+        std::function<void(Error::Ptr, bcos::protocol::Block::Ptr, bcos::protocol::Block::Ptr)>
+            _onSealed) override
+    {
+        if (m_sealTxsError)
+        {
+            _onSealed(m_sealTxsError, nullptr, nullptr);
+            return;
+        }
+        if (m_sealedTxs && m_sealedSysTxs)
+        {
+            _onSealed(nullptr, m_sealedTxs, m_sealedSysTxs);
+        }
+    }
+    void setSealedTxs(bcos::protocol::Block::Ptr _sealedTxs, bcos::protocol::Block::Ptr _sysTxs)
+    {
+        m_sealedTxs = _sealedTxs;
+        m_sealedSysTxs = _sysTxs;
+    }
+    void setSealTxsError(Error::Ptr _error) { m_sealTxsError = _error; }
 
-    // TODO: fake this interface for libsealer
-    void asyncMarkTxs(HashListPtr, bool, bcos::protocol::BlockNumber, bcos::crypto::HashType const&,
-        std::function<void(Error::Ptr)>) override
-    {}
+    // record the txs whose sealed flag is reset
+    void asyncMarkTxs(HashListPtr _txsHash, bool _sealedFlag, bcos::protocol::BlockNumber,
+        bcos::crypto::HashType const&, std::function<void(Error::Ptr)> _onRecvResponse) override
+    {
+        if (!_sealedFlag)
+        {
+            Guard l(x_unsealedTxs);
+            m_unsealedTxs.insert(m_unsealedTxs.end(), _txsHash->begin(), _txsHash->end());
+        }
+        if (_onRecvResponse)
+        {
+            _onRecvResponse(nullptr);
+        }
+    }
+    HashList unsealedTxs()
+    {
+        Guard l(x_unsealedTxs);
+        return m_unsealedTxs;
+    }
 
     void asyncVerifyBlock(PublicPtr, bytesConstRef const&,
         std::function<void(Error::Ptr, bool)> _onVerifyFinished) override
@@ -103,6 +135,11 @@ public:
 private:
     bool m_verifyResult = true;
     std::shared_ptr<ThreadPool> m_worker = nullptr;
+    bcos::protocol::Block::Ptr m_sealedTxs;
+    bcos::protocol::Block::Ptr m_sealedSysTxs;
+    Error::Ptr m_sealTxsError;
+    HashList m_unsealedTxs;
+    Mutex x_unsealedTxs;
 };
 }  // namespace test
 }  // namespace bcos
\ No newline at end of file